@@ -0,0 +1,31 @@
+#include "ActionInitialization.hh"
+#include "DetectorConstruction.hh"
+#include "EventAction.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "RunAction.hh"
+#include "StackingAction.hh"
+#include "SteppingAction.hh"
+
+ActionInitialization::ActionInitialization(const DetectorConstruction* det)
+  : G4VUserActionInitialization(), detector(det) {}
+
+
+ActionInitialization::~ActionInitialization() {}
+
+
+void ActionInitialization::BuildForMaster() const {
+  SetUserAction(new RunAction(detector));
+}
+
+
+void ActionInitialization::Build() const {
+
+  RunAction* run = new RunAction(detector);
+  SetUserAction(run);
+  SetUserAction(new PrimaryGeneratorAction(detector));
+
+  EventAction* event = new EventAction(detector, run);
+  SetUserAction(event);
+  SetUserAction(new SteppingAction(detector, event));
+  SetUserAction(new StackingAction(detector, run));
+}
@@ -0,0 +1,25 @@
+#ifndef ActionInitialization_h
+#define ActionInitialization_h 1
+
+#include "G4VUserActionInitialization.hh"
+
+class DetectorConstruction;
+
+// The master only merges runs, so it gets a RunAction alone; every worker
+// gets the full set, wired to its own RunAction and EventAction.
+class ActionInitialization : public G4VUserActionInitialization {
+
+public:
+
+  ActionInitialization(const DetectorConstruction* det);
+  virtual ~ActionInitialization();
+
+  virtual void BuildForMaster() const;
+  virtual void Build() const;
+
+private:
+
+  const DetectorConstruction* detector;
+};
+
+#endif
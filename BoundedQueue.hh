@@ -0,0 +1,91 @@
+#ifndef BoundedQueue_h
+#define BoundedQueue_h 1
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free multi-producer multi-consumer queue (D. Vyukov's
+// sequence-numbered ring). Capacity is rounded up to a power of two.
+// TryPush/TryPop never block; callers decide how to wait.
+template <class T>
+class BoundedQueue {
+
+public:
+
+  explicit BoundedQueue(size_t capacity) {
+    size_t n = 2;
+    while (n < capacity) n <<= 1;
+    mask = n - 1;
+    cells.reset(new Cell[n]);
+    for (size_t i=0; i<n; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    enqueuePos.store(0, std::memory_order_relaxed);
+    dequeuePos.store(0, std::memory_order_relaxed);
+  }
+
+  bool TryPush(T&& value) {
+    Cell* cell;
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &cells[pos & mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPop(T& value) {
+    Cell* cell;
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &cells[pos & mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (diff == 0) {
+        if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(cell->data);
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Approximate number of queued elements, for monitoring only
+  size_t Size() const {
+    size_t in  = enqueuePos.load(std::memory_order_relaxed);
+    size_t out = dequeuePos.load(std::memory_order_relaxed);
+    return in > out ? in - out : 0;
+  }
+
+  size_t Capacity() const { return mask + 1; }
+
+private:
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T                   data;
+  };
+
+  std::unique_ptr<Cell[]> cells;
+  size_t                  mask;
+
+  alignas(64) std::atomic<size_t> enqueuePos;
+  alignas(64) std::atomic<size_t> dequeuePos;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "CoincidenceMatrix.hh"
+#include "DetectorConstruction.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <cmath>
+#include <fstream>
+
+CoincidenceMatrix::CoincidenceMatrix() : detector(0), id(-1) {}
+
+
+void CoincidenceMatrix::Book(HistogramSet& set, const DetectorConstruction* det) {
+
+  detector = det;
+  const std::vector<TileInfo>& tiles = detector->GetTiles();
+  index.assign(tiles.size(), -1);
+  topTiles.clear();
+  bottomTiles.clear();
+  G4int n = detector->GetTilesPerStation();
+  for (const TileInfo& tile : tiles) {
+    // Layouts without a tile-pair table get an empty matrix
+    if (!detector->HasPairTable()) break;
+    if (tile.station == 0) {
+      std::vector<G4int>& list = (tile.plane == kTopPlane) ? topTiles : bottomTiles;
+      index[tile.id] = (G4int)list.size();
+      list.push_back(tile.id);
+    } else {
+      index[tile.id] = index[tile.id % n];
+    }
+  }
+  id = set.Book("coincidence", GetNumberOfRows()*GetNumberOfColumns(), 1, 0., 1.);
+}
+
+
+void CoincidenceMatrix::Fill(HistogramSet& set, const std::vector<G4double>& tileEdep,
+                             G4double threshold, G4double weight) {
+
+  const std::vector<TileInfo>& tiles = detector->GetTiles();
+  topHits.clear();
+  bottomHits.clear();
+  for (size_t k=0; k<tileEdep.size(); ++k) {
+    if (tileEdep[k] <= threshold) continue;
+    (tiles[k].plane == kTopPlane ? topHits : bottomHits).push_back(k);
+  }
+
+  for (G4int top : topHits)
+    for (G4int bottom : bottomHits) 
+      if (tiles[top].station == tiles[bottom].station) set.Fill(id, GetCell(top, bottom), 0.5, weight);
+}
+
+
+void CoincidenceMatrix::Write(const HistogramSet& set, G4int nEvents, const G4String& file) const {
+
+  const std::vector<TileInfo>& tiles = detector->GetTiles();
+  std::ofstream out(file.c_str());
+  out << "# " << nEvents << " events, " << GetNumberOfRows() << " top x " 
+      << GetNumberOfColumns() << " bottom tiles, summed over " 
+      << detector->GetNumberOfStations() << " stations\n"
+      << "# top bottom sumw sumw2 rate error zenith[deg] distance[cm]\n";
+  for (G4int row=0; row<GetNumberOfRows(); ++row) {
+    for (G4int column=0; column<GetNumberOfColumns(); ++column) {
+      G4int cell = row*GetNumberOfColumns() + column;
+      G4double sumW  = set.GetSumW(id, cell, 1);
+      G4double sumW2 = set.GetSumW2(id, cell, 1);
+      if (sumW == 0) continue;
+
+      // Mean of the per-event weight w*hit and the standard error of that mean
+      G4double rate  = sumW/nEvents;
+      G4double error = std::sqrt(std::max(0., sumW2/nEvents - rate*rate)/nEvents);
+      const TilePair& pair = detector->GetTilePair(topTiles[row], bottomTiles[column]);
+      out << tiles[topTiles[row]].name << ' ' << tiles[bottomTiles[column]].name << ' '
+          << sumW << ' ' << sumW2 << ' ' << rate << ' ' << error << ' '
+          << pair.zenith/CLHEP::deg << ' ' << pair.distance/CLHEP::cm << '\n';
+    }
+  }
+}
@@ -0,0 +1,50 @@
+#ifndef CoincidenceMatrix_h
+#define CoincidenceMatrix_h 1
+
+#include "HistogramSet.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class DetectorConstruction;
+
+// Weighted rate of every (top tile, bottom tile) pair, kept as a dense
+// nTop x nBottom family of one-bin histograms in a HistogramSet so that it
+// is filled per thread and merged with the other histograms. Rows and
+// columns are the top and bottom tiles of one station in tile id order;
+// pairs within the other stations are summed into the same cells.
+class CoincidenceMatrix {
+
+public:
+
+  CoincidenceMatrix();
+
+  void Book(HistogramSet& set, const DetectorConstruction* det);
+
+  // Every pair of tiles above threshold in the two planes gets the event weight
+  void Fill(HistogramSet& set, const std::vector<G4double>& tileEdep, G4double threshold,
+            G4double weight);
+
+  G4int GetNumberOfRows() const    { return (G4int)topTiles.size(); }
+  G4int GetNumberOfColumns() const { return (G4int)bottomTiles.size(); }
+  G4int GetCell(G4int top, G4int bottom) const { 
+    return index[top]*GetNumberOfColumns() + index[bottom]; 
+  }
+
+  // Rate per event and its standard error for every pair with entries, as
+  // text: top tile, bottom tile, sum w, sum w2, rate, error and the
+  // nominal zenith angle and distance of the pair
+  void Write(const HistogramSet& set, G4int nEvents, const G4String& file) const;
+
+private:
+
+  const DetectorConstruction* detector;
+  G4int              id;
+  std::vector<G4int> index;
+  std::vector<G4int> topTiles;
+  std::vector<G4int> bottomTiles;
+  std::vector<G4int> topHits;      // tile ids
+  std::vector<G4int> bottomHits;
+};
+
+#endif
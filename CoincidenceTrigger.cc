@@ -0,0 +1,69 @@
+#include "CoincidenceTrigger.hh"
+
+#include "G4GenericMessenger.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cfloat>
+
+CoincidenceTrigger::CoincidenceTrigger(const DetectorConstruction* det) 
+  : detector(det), threshold(0.5*CLHEP::MeV), margin(10.0*CLHEP::cm),
+    earlyAbort(true), nPrimaries(1) {
+
+  Reset();
+
+  messenger = new G4GenericMessenger(this, "/cosmic/trigger/", "Top/bottom coincidence trigger");
+  messenger->DeclarePropertyWithUnit("threshold", "MeV", threshold, 
+                                     "Energy deposit needed in a plane to count it as hit");
+  messenger->DeclarePropertyWithUnit("margin", "cm", margin,
+                                     "Margin around the plane footprint before giving up");
+  messenger->DeclareProperty("earlyAbort", earlyAbort,
+                             "Abort the event once a coincidence is impossible");
+}
+
+
+CoincidenceTrigger::~CoincidenceTrigger() {
+  delete messenger;
+}
+
+
+void CoincidenceTrigger::Reset(G4int primaries) {
+  nPrimaries = primaries;
+  for (G4int p=0; p<kNumPlanes; ++p) planeEdep[p] = 0;
+}
+
+
+G4bool CoincidenceTrigger::IsImpossible(const G4ThreeVector& pos, 
+                                        const G4ThreeVector& dir) const {
+
+  if (!earlyAbort || nPrimaries > 1) return false;
+  for (G4int p=0; p<kNumPlanes; ++p) {
+    if (detector->HasPlane(p) && !HasHit(p) && CannotReach(p, pos, dir)) return true;
+  }
+  return false;
+}
+
+
+G4bool CoincidenceTrigger::CannotReach(G4int plane, const G4ThreeVector& pos,
+                                       const G4ThreeVector& dir) const {
+
+  G4ThreeVector lo = detector->GetPlaneMin(plane) - G4ThreeVector(margin, margin, margin);
+  G4ThreeVector hi = detector->GetPlaneMax(plane) + G4ThreeVector(margin, margin, margin);
+
+  // Straight line clipped against the box, one slab per axis: the track can
+  // reach the plane only if the intervals overlap ahead of it. Inclined
+  // tracks may enter through a side face, so all three axes count.
+  G4double tNear = 0, tFar = DBL_MAX;
+  for (G4int i=0; i<3; ++i) {
+    if (dir[i] == 0) {
+      if (pos[i] < lo[i] || pos[i] > hi[i]) return true;
+      continue;
+    }
+    G4double t1 = (lo[i] - pos[i])/dir[i];
+    G4double t2 = (hi[i] - pos[i])/dir[i];
+    tNear = std::max(tNear, std::min(t1, t2));
+    tFar  = std::min(tFar,  std::max(t1, t2));
+  }
+  return tNear > tFar;
+}
@@ -0,0 +1,53 @@
+#ifndef CoincidenceTrigger_h
+#define CoincidenceTrigger_h 1
+
+#include "DetectorConstruction.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+class G4GenericMessenger;
+
+// Tracks which planes saw energy above threshold in the current event and
+// decides, from the primary's position and direction, when a top/bottom
+// coincidence can no longer happen so the event can be aborted early.
+class CoincidenceTrigger {
+
+public:
+
+  CoincidenceTrigger(const DetectorConstruction* det);
+  ~CoincidenceTrigger();
+
+  // An event with several primaries, such as an air shower, is never
+  // aborted early: one primary missing the planes says nothing about the
+  // others
+  void Reset(G4int primaries = 1);
+  void AddEdep(G4int plane, G4double edep) { planeEdep[plane] += edep; }
+
+  G4bool HasHit(G4int plane) const { return planeEdep[plane] > threshold; }
+  // Every built plane above threshold, a single plane on its own
+  G4bool Fired() const { 
+    return (HasHit(kBottomPlane) || !detector->HasPlane(kBottomPlane)) &&
+           (HasHit(kTopPlane)    || !detector->HasPlane(kTopPlane));
+  }
+  G4bool IsImpossible(const G4ThreeVector& pos, const G4ThreeVector& dir) const;
+
+  G4double GetThreshold() const  { return threshold; }
+  void SetThreshold(G4double val) { threshold = val; }
+  void SetMargin(G4double val)    { margin = val; }
+  void SetEarlyAbort(G4bool val)  { earlyAbort = val; }
+
+private:
+
+  G4bool CannotReach(G4int plane, const G4ThreeVector& pos, const G4ThreeVector& dir) const;
+
+  const DetectorConstruction* detector;
+  G4double planeEdep[kNumPlanes];
+  G4double threshold;
+  G4double margin;
+  G4bool   earlyAbort;
+  G4int    nPrimaries;
+
+  G4GenericMessenger* messenger;
+};
+
+#endif
@@ -0,0 +1,266 @@
+#ifndef DetectorConstruction_h
+#define DetectorConstruction_h 1
+
+#include "G4VUserDetectorConstruction.hh"
+#include "G4RotationMatrix.hh"
+#include "G4ThreeVector.hh"
+#include "G4Transform3D.hh"
+#include "globals.hh"
+
+#include "TileInfo.hh"
+#include "TileHull.hh"
+
+#include <array>
+#include <map>
+#include <vector>
+
+class G4AssemblyVolume;
+class G4Material;
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+class G4UserLimits;
+class G4VSolid;
+class G4VTouchable;
+class DetectorMessenger;
+
+class DetectorConstruction : public G4VUserDetectorConstruction {
+
+public:
+
+  DetectorConstruction();
+  ~DetectorConstruction();
+
+  G4VPhysicalVolume* Construct();
+
+  // Tile table, filled at the end of Construct(). The plane volumes are
+  // placed once per station with copy number station*kNumPlanes + plane, and
+  // the copy number of a scintillator placement counts within its plane, so
+  // the dense tile id needs the touchable.
+  const std::vector<TileInfo>& GetTiles() const { return tiles; }
+  G4int GetNumberOfTiles() const { return (G4int)tiles.size(); }
+  G4int GetTileId(const G4VTouchable* touchable) const;
+
+  // Counts the tile table rebuilds, i.e. geometry changes and alignments,
+  // so that tables derived from the tiles can tell when they are stale
+  G4int GetTableVersion() const { return tableVersion; }
+
+  // Stations of the array, translated copies of the two planes. The tiles of
+  // a station follow those of the station before, so that tile ids modulo
+  // GetTilesPerStation() are the same tile in every station.
+  G4int GetNumberOfStations() const { return nStations; }
+  G4int GetTilesPerStation() const { return tilesPerStation; }
+
+  // Station origins from a text file, one "x y z" line in cm per station, or
+  // n stations on a square grid with the given pitch. Without either the
+  // detector is a single station at the origin.
+  void SetStationTable(const G4String& file);
+  void SetStationGrid(G4int n);
+  void SetStationPitch(G4double val);
+
+  // Construction time, voxel memory, resident memory and navigation
+  // throughput for grids of 1, 2, 4, ... maxStations stations
+  void BenchmarkStations(G4int maxStations, G4int nRays);
+
+  // Replace the measured tiles by a synthetic layout of n tiles built by
+  // the same rules, half in each plane; 0 restores the measured layout
+  void SetSyntheticTiles(G4int n);
+  G4int GetSyntheticTiles() const { return syntheticTiles; }
+
+  // The same figures for synthetic layouts of 100, 1000, ... maxTiles tiles
+  void BenchmarkLayouts(G4int maxTiles, G4int nRays);
+
+  // Per-tile misalignment from a text file, one "name dx dy dz rx ry rz"
+  // line per tile: a shift in mm and rotations in mrad about the x, y and z
+  // axes through the tile centre. The wrapper, scintillator and PMT move
+  // together, stations take the deltas of their tile in the first one. The
+  // existing placements are moved and only the plane volumes concerned are
+  // re-voxelised; the table is kept across geometry rebuilds.
+  void SetAlignmentTable(const G4String& file);
+  void ResetAlignment();
+
+  // Global-to-local transform of every tile, flattened row-major 3x4
+  // [R | t] and indexed by tile id (the scintillator copy number), so that
+  // local = R*global + t needs no touchable history
+  const G4double* GetLocalTransform(G4int tile) const { return &localTransforms[12*tile]; }
+  inline G4ThreeVector ToLocalPoint(G4int tile, const G4ThreeVector& p) const;
+  inline G4ThreeVector ToLocalAxis(G4int tile, const G4ThreeVector& d) const;
+
+  // Tile-pair table of one station, filled with the tile table. Tiles of
+  // other stations stand for their copy in the first one. The table gates
+  // every structure that grows with the square of the tile count: it is
+  // built only when it, plus one thread's pair-time histograms, coincidence
+  // matrix and generator pair table, fits in kMaxPairMemory.
+  static const size_t kMaxPairMemory = 64*1024*1024;
+  G4bool HasPairTable() const { return !tilePairs.empty(); }
+  const TilePair& GetTilePair(G4int a, G4int b) const { 
+    return tilePairs[(a % tilesPerStation)*tilesPerStation + b % tilesPerStation]; 
+  }
+  void WritePairTable(const G4String& file) const;
+
+  // PMT placements, numbered like the tiles
+  G4int GetNumberOfPmts() const { return (G4int)pmts.size(); }
+  G4int GetPmtId(const G4VTouchable* touchable) const;
+
+  // Global bounding box of all tiles in one plane, empty (min > max) for a
+  // plane that is not built, and of the tiles of all built planes
+  const G4ThreeVector& GetPlaneMin(G4int plane) const { return planeMin[plane]; }
+  const G4ThreeVector& GetPlaneMax(G4int plane) const { return planeMax[plane]; }
+  G4ThreeVector GetDetectorMin() const;
+  G4ThreeVector GetDetectorMax() const;
+
+  // Build "both" planes, only the "top" or only the "bottom" one; the world
+  // shrinks to the planes that are built
+  void SetPlanes(const G4String& val);
+  G4bool HasPlane(G4int plane) const { return buildPlane[plane]; }
+
+  // Convex envelope of the tiles, used to decide whether a track can reach one
+  const TileHull& GetTileHull() const { return tileHull; }
+
+  // Air shell between a margin around the detector and the world boundary.
+  // Tracks entering it are killed by the stepping action, and by
+  // G4UserSpecialCuts if the physics list has it.
+  void SetKillerShell(G4bool val);
+  void SetKillerMargin(G4double val);
+  G4bool IsKillerVolume(const G4VPhysicalVolume* pv) const;
+
+  // Solid of the scintillator tiles: the specialised SymmetricTrap by
+  // default, or the general G4Trap for comparison
+  void SetTileSolid(const G4String& val);
+
+  // Solid of the aluminium wrappers: the TrapShell by default, or the
+  // G4SubtractionSolid of two G4Traps for comparison
+  void SetWrapperSolid(const G4String& val);
+
+  // Cross-check every specialised tile and wrapper solid against the
+  // equivalent Geant4 construction on nPoints random points and directions
+  // each, and time both
+  void CheckSolids(G4int nPoints) const;
+
+  // Navigation throughput of the current geometry: nRays straight rays
+  // through the detector, relocated at every boundary like a geantino.
+  // Returns the steps per second.
+  G4double BenchmarkNavigation(G4int nRays) const;
+
+private:
+
+  void DefineMaterials();
+  G4RotationMatrix* AddMatrix(G4double th1, G4double phi1, G4double th2,
+                              G4double phi2, G4double th3, G4double phi3);
+
+  void PlaceMeasuredTiles(G4LogicalVolume* logB, G4LogicalVolume* logT);
+  void PlaceSyntheticTiles(G4LogicalVolume* logB, G4LogicalVolume* logT, G4int nTiles);
+  void BuildTileTable(G4VPhysicalVolume* world);
+  void BuildPairTable();
+  void CollectTiles(G4LogicalVolume* plane, const G4AffineTransform& toGlobal, G4int planeIndex,
+                    G4int station);
+  void BuildKillerShell(G4LogicalVolume* mother, const G4ThreeVector& motherHalf);
+  void DaughterLimits(const G4LogicalVolume* mother, G4ThreeVector& lo, G4ThreeVector& hi) const;
+
+  // Shrink the box of a plane volume around its modules and recentre them,
+  // returns where the box centre was in the calorimeter frame
+  G4ThreeVector FitPlaneVolume(G4LogicalVolume* plane) const;
+  void CheckStations(const std::vector<G4ThreeVector>& offsets,
+                     G4LogicalVolume* const planeVolumes[kNumPlanes],
+                     const G4ThreeVector planeCentres[kNumPlanes]) const;
+  void MakeStationGrid(G4int n);
+  void RecordModulePlacements();
+  void RestoreNominalPlacements();
+  void ApplyAlignment(G4bool revoxelise);
+  G4double GetVoxelMemory() const;
+
+  // Build the current geometry outside of the run manager and print one
+  // benchmark line, labelled with label
+  void BenchmarkConstruction(G4int label, G4int nRays);
+  G4VSolid* MakeTile(const G4String& name, G4double dz, G4double dy,
+                     G4double bl1, G4double bl2) const;
+  G4VSolid* MakeWrapper(const G4String& name, G4double dz, G4double dy,
+                        G4double bl1, G4double bl2, G4double wall) const;
+
+  // One tile module per wrapper size: the aluminium wrapper, the
+  // scintillator in its cavity and the PMT, built on first use
+  G4AssemblyVolume* GetTileModule(G4double dz, G4double dy, G4double bl1, G4double bl2);
+
+  // Imprint the module of a wrapper with these half lengths at transform in
+  // mother, the wrapper and scintillator placements getting the given names.
+  // A null mother, a plane that is not built, gets nothing.
+  void PlaceTileModule(G4LogicalVolume* mother, const G4Transform3D& transform,
+                       const G4String& wrapperName, const G4String& tileName,
+                       G4double dz, G4double dy, G4double bl1, G4double bl2);
+
+  G4Material* pSci;
+  G4Material* pAir;
+  G4Material* wrapperMaterial;
+
+  G4LogicalVolume*                                      pmtVolume;
+  std::map<std::array<G4double, 4>, G4AssemblyVolume*> tileModules;
+
+  std::vector<TileInfo> tiles;
+  std::vector<G4VPhysicalVolume*> pmts;
+  std::vector<G4int>              planeFirstTile;
+  std::vector<G4int>              planeFirstPmt;
+  std::vector<TilePair>           tilePairs;
+  std::vector<G4double>           localTransforms;
+  G4ThreeVector         planeMin[kNumPlanes];
+  G4ThreeVector         planeMax[kNumPlanes];
+  TileHull              tileHull;
+
+  G4bool        killerShell;
+  G4double      killerMargin;
+  G4UserLimits* killerLimits;
+  G4bool        symmetricTiles;
+  G4bool        shellWrappers;
+  G4int         syntheticTiles;
+  G4bool        buildPlane[kNumPlanes];
+
+  struct TileAlignment {
+    G4ThreeVector    shift;
+    G4RotationMatrix rotation;
+  };
+
+  // Placements of one tile module of the first station, wrapper,
+  // scintillator and PMT, with the nominal transforms the alignment is
+  // applied to. The aligned rotations are owned here, the nominal ones by
+  // the assembly, which deletes whatever rotation its placements hold, so
+  // they are put back before the assemblies go.
+  struct ModulePlacement {
+    G4VPhysicalVolume* plane;
+    G4int              tile;
+    G4bool             moved;
+    G4ThreeVector      centre;
+    G4VPhysicalVolume* volumes[3];
+    G4RotationMatrix*  nominalRotation[3];
+    G4ThreeVector      nominalTranslation[3];
+    G4RotationMatrix   alignedRotation[3];
+  };
+
+  std::map<G4String, TileAlignment> alignment;
+  std::vector<ModulePlacement>      modulePlacements;
+
+  std::vector<G4ThreeVector> stations;
+  G4int                      nStations;
+  G4int                      tilesPerStation;
+  G4double                   stationPitch;
+
+  G4VPhysicalVolume* worldVolume;
+  G4int              tableVersion;
+
+  DetectorMessenger* detectorMessenger;
+};
+
+
+inline G4ThreeVector DetectorConstruction::ToLocalPoint(G4int tile, const G4ThreeVector& p) const {
+  const G4double* m = &localTransforms[12*tile];
+  return G4ThreeVector(m[0]*p.x() + m[1]*p.y() + m[2]*p.z()  + m[3],
+                       m[4]*p.x() + m[5]*p.y() + m[6]*p.z()  + m[7],
+                       m[8]*p.x() + m[9]*p.y() + m[10]*p.z() + m[11]);
+}
+
+
+inline G4ThreeVector DetectorConstruction::ToLocalAxis(G4int tile, const G4ThreeVector& d) const {
+  const G4double* m = &localTransforms[12*tile];
+  return G4ThreeVector(m[0]*d.x() + m[1]*d.y() + m[2]*d.z(),
+                       m[4]*d.x() + m[5]*d.y() + m[6]*d.z(),
+                       m[8]*d.x() + m[9]*d.y() + m[10]*d.z());
+}
+
+#endif
@@ -0,0 +1,203 @@
+#include "DetectorMessenger.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
+
+DetectorMessenger::DetectorMessenger(DetectorConstruction* det) : detector(det) {
+
+  detDir = new G4UIdirectory("/cosmic/det/");
+  detDir->SetGuidance("Detector construction control");
+
+  killerCmd = new G4UIcmdWithABool("/cosmic/det/killer", this);
+  killerCmd->SetGuidance("Kill tracks leaving the detector volume into the world air");
+  killerCmd->SetGuidance("(switch off for validation runs)");
+  killerCmd->SetParameterName("killer", false);
+  killerCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  killerMarginCmd = new G4UIcmdWithADoubleAndUnit("/cosmic/det/killerMargin", this);
+  killerMarginCmd->SetGuidance("Margin between the detector volumes and the killer shell");
+  killerMarginCmd->SetParameterName("margin", false);
+  killerMarginCmd->SetRange("margin>0.");
+  killerMarginCmd->SetUnitCategory("Length");
+  killerMarginCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  pairTableCmd = new G4UIcmdWithAString("/cosmic/det/writePairTable", this);
+  pairTableCmd->SetGuidance("Write distance, zenith angle and time of flight of every");
+  pairTableCmd->SetGuidance("top/bottom tile pair");
+  pairTableCmd->SetParameterName("file", false);
+  pairTableCmd->AvailableForStates(G4State_Idle);
+
+  tileSolidCmd = new G4UIcmdWithAString("/cosmic/det/tileSolid", this);
+  tileSolidCmd->SetGuidance("Solid of the scintillator tiles: the specialised symmetric");
+  tileSolidCmd->SetGuidance("trapezoid or the general G4Trap");
+  tileSolidCmd->SetParameterName("solid", false);
+  tileSolidCmd->SetCandidates("symmetric trap");
+  tileSolidCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  wrapperSolidCmd = new G4UIcmdWithAString("/cosmic/det/wrapperSolid", this);
+  wrapperSolidCmd->SetGuidance("Solid of the aluminium wrappers: the trapezoidal shell or the");
+  wrapperSolidCmd->SetGuidance("Boolean subtraction of two G4Traps");
+  wrapperSolidCmd->SetParameterName("solid", false);
+  wrapperSolidCmd->SetCandidates("shell boolean");
+  wrapperSolidCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  checkSolidsCmd = new G4UIcmdWithAnInteger("/cosmic/det/checkSolids", this);
+  checkSolidsCmd->SetGuidance("Cross-check the tile and wrapper solids against G4Trap and");
+  checkSolidsCmd->SetGuidance("G4SubtractionSolid on random points and directions, and time");
+  checkSolidsCmd->SetGuidance("the navigation queries of both");
+  checkSolidsCmd->SetParameterName("points", true);
+  checkSolidsCmd->SetDefaultValue(100000);
+  checkSolidsCmd->SetRange("points>0");
+  checkSolidsCmd->AvailableForStates(G4State_Idle);
+
+  navBenchCmd = new G4UIcmdWithAnInteger("/cosmic/det/benchmarkNavigation", this);
+  navBenchCmd->SetGuidance("Time straight rays through the current geometry, relocated at");
+  navBenchCmd->SetGuidance("every boundary, and print the navigation steps per second");
+  navBenchCmd->SetParameterName("rays", true);
+  navBenchCmd->SetDefaultValue(100000);
+  navBenchCmd->SetRange("rays>0");
+  navBenchCmd->AvailableForStates(G4State_Idle);
+
+  stationTableCmd = new G4UIcmdWithAString("/cosmic/det/stationTable", this);
+  stationTableCmd->SetGuidance("Place the two planes once per station of a text file, one");
+  stationTableCmd->SetGuidance("\"x y z\" origin in cm per line");
+  stationTableCmd->SetParameterName("file", false);
+  stationTableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  stationGridCmd = new G4UIcmdWithAnInteger("/cosmic/det/stationGrid", this);
+  stationGridCmd->SetGuidance("Place the two planes once per station of a square grid");
+  stationGridCmd->SetGuidance("centred on the origin (1 for the single detector)");
+  stationGridCmd->SetParameterName("stations", false);
+  stationGridCmd->SetRange("stations>0");
+  stationGridCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  stationPitchCmd = new G4UIcmdWithADoubleAndUnit("/cosmic/det/stationPitch", this);
+  stationPitchCmd->SetGuidance("Distance between neighbouring stations of the grid");
+  stationPitchCmd->SetParameterName("pitch", false);
+  stationPitchCmd->SetRange("pitch>0.");
+  stationPitchCmd->SetUnitCategory("Length");
+  stationPitchCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  stationBenchCmd = new G4UIcommand("/cosmic/det/benchmarkStations", this);
+  stationBenchCmd->SetGuidance("Construction time, voxel memory, resident memory and");
+  stationBenchCmd->SetGuidance("navigation steps per second for station grids of 1, 2, 4, ...");
+  G4UIparameter* stationsParam = new G4UIparameter("stations", 'i', false);
+  stationsParam->SetParameterRange("stations>0");
+  stationBenchCmd->SetParameter(stationsParam);
+  G4UIparameter* raysParam = new G4UIparameter("rays", 'i', true);
+  raysParam->SetDefaultValue(100000);
+  raysParam->SetParameterRange("rays>0");
+  stationBenchCmd->SetParameter(raysParam);
+  stationBenchCmd->AvailableForStates(G4State_Idle);
+
+  syntheticCmd = new G4UIcmdWithAnInteger("/cosmic/det/syntheticTiles", this);
+  syntheticCmd->SetGuidance("Replace the measured planes by a synthetic layout of this many");
+  syntheticCmd->SetGuidance("tiles in 4.5 deg wedges, half in each plane (0 for the measured one)");
+  syntheticCmd->SetParameterName("tiles", false);
+  syntheticCmd->SetRange("tiles>=0");
+  syntheticCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  layoutBenchCmd = new G4UIcommand("/cosmic/det/benchmarkLayouts", this);
+  layoutBenchCmd->SetGuidance("Construction time, voxel memory, resident memory and");
+  layoutBenchCmd->SetGuidance("navigation steps per second for synthetic layouts of");
+  layoutBenchCmd->SetGuidance("100, 1000, ... tiles");
+  G4UIparameter* tilesParam = new G4UIparameter("tiles", 'i', false);
+  tilesParam->SetParameterRange("tiles>=100");
+  layoutBenchCmd->SetParameter(tilesParam);
+  G4UIparameter* layoutRaysParam = new G4UIparameter("rays", 'i', true);
+  layoutRaysParam->SetDefaultValue(100000);
+  layoutRaysParam->SetParameterRange("rays>0");
+  layoutBenchCmd->SetParameter(layoutRaysParam);
+  layoutBenchCmd->AvailableForStates(G4State_Idle);
+
+  planesCmd = new G4UIcmdWithAString("/cosmic/det/planes", this);
+  planesCmd->SetGuidance("Build both planes, only the top or only the bottom one; the world");
+  planesCmd->SetGuidance("shrinks to the planes built and the trigger needs only those");
+  planesCmd->SetParameterName("planes", false);
+  planesCmd->SetCandidates("both top bottom");
+  planesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  alignmentCmd = new G4UIcmdWithAString("/cosmic/det/alignment", this);
+  alignmentCmd->SetGuidance("Misalign tile modules from a text file, one \"name dx dy dz rx ry rz\"");
+  alignmentCmd->SetGuidance("line per tile with shifts in mm and rotations in mrad. Moves the");
+  alignmentCmd->SetGuidance("existing placements and re-voxelises only the planes concerned");
+  alignmentCmd->SetParameterName("file", false);
+  alignmentCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  resetAlignmentCmd = new G4UIcmdWithoutParameter("/cosmic/det/resetAlignment", this);
+  resetAlignmentCmd->SetGuidance("Put every tile module back at its nominal placement");
+  resetAlignmentCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+
+DetectorMessenger::~DetectorMessenger() {
+
+  delete killerCmd;
+  delete killerMarginCmd;
+  delete pairTableCmd;
+  delete tileSolidCmd;
+  delete wrapperSolidCmd;
+  delete checkSolidsCmd;
+  delete navBenchCmd;
+  delete stationTableCmd;
+  delete stationGridCmd;
+  delete stationPitchCmd;
+  delete stationBenchCmd;
+  delete syntheticCmd;
+  delete layoutBenchCmd;
+  delete planesCmd;
+  delete alignmentCmd;
+  delete resetAlignmentCmd;
+  delete detDir;
+}
+
+
+void DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue) {
+
+  if (command == killerCmd) {
+    detector->SetKillerShell(killerCmd->GetNewBoolValue(newValue));
+  } else if (command == killerMarginCmd) {
+    detector->SetKillerMargin(killerMarginCmd->GetNewDoubleValue(newValue));
+  } else if (command == pairTableCmd) {
+    detector->WritePairTable(newValue);
+  } else if (command == tileSolidCmd) {
+    detector->SetTileSolid(newValue);
+  } else if (command == wrapperSolidCmd) {
+    detector->SetWrapperSolid(newValue);
+  } else if (command == checkSolidsCmd) {
+    detector->CheckSolids(checkSolidsCmd->GetNewIntValue(newValue));
+  } else if (command == navBenchCmd) {
+    detector->BenchmarkNavigation(navBenchCmd->GetNewIntValue(newValue));
+  } else if (command == stationTableCmd) {
+    detector->SetStationTable(newValue);
+  } else if (command == stationGridCmd) {
+    detector->SetStationGrid(stationGridCmd->GetNewIntValue(newValue));
+  } else if (command == stationPitchCmd) {
+    detector->SetStationPitch(stationPitchCmd->GetNewDoubleValue(newValue));
+  } else if (command == stationBenchCmd) {
+    G4int stations, rays;
+    std::istringstream(newValue) >> stations >> rays;
+    detector->BenchmarkStations(stations, rays);
+  } else if (command == syntheticCmd) {
+    detector->SetSyntheticTiles(syntheticCmd->GetNewIntValue(newValue));
+  } else if (command == layoutBenchCmd) {
+    G4int tiles, rays;
+    std::istringstream(newValue) >> tiles >> rays;
+    detector->BenchmarkLayouts(tiles, rays);
+  } else if (command == planesCmd) {
+    detector->SetPlanes(newValue);
+  } else if (command == alignmentCmd) {
+    detector->SetAlignmentTable(newValue);
+  } else if (command == resetAlignmentCmd) {
+    detector->ResetAlignment();
+  }
+}
@@ -0,0 +1,48 @@
+#ifndef DetectorMessenger_h
+#define DetectorMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class DetectorConstruction;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+class DetectorMessenger : public G4UImessenger {
+
+public:
+
+  DetectorMessenger(DetectorConstruction*);
+  ~DetectorMessenger();
+
+  void SetNewValue(G4UIcommand*, G4String);
+
+private:
+
+  DetectorConstruction*      detector;
+
+  G4UIdirectory*             detDir;
+  G4UIcmdWithABool*          killerCmd;
+  G4UIcmdWithADoubleAndUnit* killerMarginCmd;
+  G4UIcmdWithAString*        pairTableCmd;
+  G4UIcmdWithAString*        tileSolidCmd;
+  G4UIcmdWithAString*        wrapperSolidCmd;
+  G4UIcmdWithAnInteger*      checkSolidsCmd;
+  G4UIcmdWithAnInteger*      navBenchCmd;
+  G4UIcmdWithAString*        stationTableCmd;
+  G4UIcmdWithAnInteger*      stationGridCmd;
+  G4UIcmdWithADoubleAndUnit* stationPitchCmd;
+  G4UIcommand*               stationBenchCmd;
+  G4UIcmdWithAnInteger*      syntheticCmd;
+  G4UIcommand*               layoutBenchCmd;
+  G4UIcmdWithAString*        planesCmd;
+  G4UIcmdWithAString*        alignmentCmd;
+  G4UIcmdWithoutParameter*   resetAlignmentCmd;
+};
+
+#endif
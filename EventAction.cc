@@ -0,0 +1,73 @@
+#include "EventAction.hh"
+#include "DetectorConstruction.hh"
+#include "RunAction.hh"
+
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4RunManager.hh"
+
+#include <cfloat>
+
+EventAction::EventAction(const DetectorConstruction* det, RunAction* run)
+  : G4UserEventAction(), detector(det), runAction(run), trigger(det),
+    perfCounting(false), metrics(MetricsExporter::GetThreadCounters()) {}
+
+
+EventAction::~EventAction() {}
+
+
+void EventAction::BeginOfEventAction(const G4Event* event) {
+
+  slowEvents.BeginEvent();
+  perfCounting = perf.Start();
+  G4int primaries = 0;
+  for (G4int v=0; v<event->GetNumberOfPrimaryVertex(); ++v) 
+    primaries += event->GetPrimaryVertex(v)->GetNumberOfParticle();
+  trigger.Reset(primaries);
+  tileEdep.assign(detector->GetNumberOfTiles(), 0.);
+  tileTime.assign(detector->GetNumberOfTiles(), DBL_MAX);
+  pmtEdep.assign(detector->GetNumberOfPmts(), 0.);
+}
+
+
+void EventAction::EndOfEventAction(const G4Event* event) {
+
+  PerfCounters::Sample sample;
+  if (perfCounting && perf.Stop(sample)) {
+    perf.Accumulate(event->IsAborted() ? PerfCounters::kAborted :
+                    trigger.Fired()    ? PerfCounters::kTriggered : PerfCounters::kNotTriggered, sample);
+  }
+
+  runAction->FillEventTime(slowEvents.EndEvent(event));
+  MetricsExporter::ThreadCounters::Increment(metrics->events);
+  for (G4int p=0; p<kNumPlanes; ++p) 
+    if (trigger.HasHit(p)) MetricsExporter::ThreadCounters::Increment(metrics->planeHits[p]);
+
+  G4double weight = GetEventWeight(event);
+  runAction->CountEvent(trigger.Fired(), event->IsAborted(), weight);
+  if (event->IsAborted()) return;
+  runAction->FillHistograms(tileEdep, tileTime, pmtEdep, trigger.GetThreshold(), weight);
+  runAction->RecordHits(event->GetEventID(), tileEdep, tileTime, weight);
+  if (trigger.Fired()) runAction->FitTrack(event->GetEventID(), tileEdep, trigger.GetThreshold(), weight);
+}
+
+
+G4double EventAction::GetEventWeight(const G4Event* event) const {
+
+  G4PrimaryVertex* vertex = event->GetPrimaryVertex();
+  return vertex ? vertex->GetWeight() : 1.;
+}
+
+
+void EventAction::AddEdep(G4int tile, G4double edep, G4double time) {
+
+  tileEdep[tile] += edep;
+  if (time < tileTime[tile]) tileTime[tile] = time;
+  trigger.AddEdep(detector->GetTiles()[tile].plane, edep);
+}
+
+
+void EventAction::AbortEvent() {
+
+  G4RunManager::GetRunManager()->AbortEvent();
+}
@@ -0,0 +1,53 @@
+#ifndef EventAction_h
+#define EventAction_h 1
+
+#include "G4UserEventAction.hh"
+#include "CoincidenceTrigger.hh"
+#include "MetricsExporter.hh"
+#include "PerfCounters.hh"
+#include "SlowEventMonitor.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class DetectorConstruction;
+class RunAction;
+
+class EventAction : public G4UserEventAction {
+
+public:
+
+  EventAction(const DetectorConstruction* det, RunAction* run);
+  virtual ~EventAction();
+
+  virtual void BeginOfEventAction(const G4Event*);
+  virtual void EndOfEventAction(const G4Event*);
+
+  void AddEdep(G4int tile, G4double edep, G4double time);
+  void AddPmtEdep(G4int pmt, G4double edep) { pmtEdep[pmt] += edep; }
+  void AbortEvent();
+
+  CoincidenceTrigger& GetTrigger() { return trigger; }
+  SlowEventMonitor&   GetSlowEventMonitor() { return slowEvents; }
+
+  const std::vector<G4double>& GetTileEdep() const { return tileEdep; }
+  const std::vector<G4double>& GetTileTime() const { return tileTime; }
+
+private:
+
+  G4double GetEventWeight(const G4Event* event) const;
+
+  const DetectorConstruction* detector;
+  RunAction*                  runAction;
+  CoincidenceTrigger          trigger;
+  SlowEventMonitor            slowEvents;
+  PerfCounters                perf;
+  G4bool                      perfCounting;
+  MetricsExporter::ThreadCounters* metrics;
+
+  std::vector<G4double> tileEdep;
+  std::vector<G4double> tileTime;
+  std::vector<G4double> pmtEdep;
+};
+
+#endif
@@ -0,0 +1,146 @@
+#include "HistogramSet.hh"
+
+#include "G4AutoLock.hh"
+#include "G4Timer.hh"
+
+#include <atomic>
+#include <cfloat>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <thread>
+
+namespace {
+  G4Mutex registryMutex = G4MUTEX_INITIALIZER;
+  std::vector<HistogramSet*> registry;
+}
+
+
+HistogramSet::~HistogramSet() {
+
+  G4AutoLock lock(&registryMutex);
+  registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+}
+
+
+G4int HistogramSet::Book(const G4String& name, G4int nCells, G4int nBins,
+                         G4double min, G4double max) {
+
+  Histogram h;
+  h.name   = name;
+  h.nCells = nCells;
+  h.nBins  = nBins;
+  h.min    = min;
+  h.max    = max;
+  h.scale  = nBins/(max - min);
+  h.offset = sums.size();
+  histograms.push_back(h);
+  sums.resize(sums.size() + 2*(size_t)nCells*(nBins + 2), 0.);
+  return (G4int)histograms.size() - 1;
+}
+
+
+void HistogramSet::Reset() {
+  std::fill(sums.begin(), sums.end(), 0.);
+}
+
+
+void HistogramSet::Add(const HistogramSet& other) {
+
+  if (other.sums.size() != sums.size()) {
+    G4Exception("HistogramSet::Add", "Histo001", FatalException,
+                "Adding histogram sets with different bookings");
+    return;
+  }
+  G4double* __restrict__ to = sums.data();
+  const G4double* __restrict__ from = other.sums.data();
+  for (size_t i=0, n=sums.size(); i<n; ++i) to[i] += from[i];
+}
+
+
+void HistogramSet::Merge(const std::vector<HistogramSet*>& sets, G4int nThreads) {
+
+  std::vector<HistogramSet*> work(sets);
+  size_t n = work.size();
+
+  // Level by level: sets[i] += sets[i + stride] for every pair of the level
+  for (size_t stride=1; stride<n; stride*=2) {
+    std::vector<size_t> targets;
+    for (size_t i=0; i+stride<n; i+=2*stride) targets.push_back(i);
+
+    std::atomic<size_t> next(0);
+    auto addPairs = [&]() {
+      for (size_t t; (t = next++) < targets.size(); ) 
+        work[targets[t]]->Add(*work[targets[t] + stride]);
+    };
+    std::vector<std::thread> pool;
+    G4int nPool = std::min((G4int)targets.size(), std::max(nThreads, 1)) - 1;
+    for (G4int p=0; p<nPool; ++p) pool.emplace_back(addPairs);
+    addPairs();
+    for (std::thread& thread : pool) thread.join();
+  }
+  if (n > 0) Add(*work[0]);
+}
+
+
+void HistogramSet::Register() {
+
+  G4AutoLock lock(&registryMutex);
+  if (std::find(registry.begin(), registry.end(), this) == registry.end()) registry.push_back(this);
+}
+
+
+std::vector<HistogramSet*> HistogramSet::GetRegistered() {
+
+  G4AutoLock lock(&registryMutex);
+  return registry;
+}
+
+
+void HistogramSet::BenchmarkMerge(G4int maxThreads) const {
+
+  std::vector<HistogramSet> copies(maxThreads, *this);
+  std::mt19937_64 engine(12345);
+  std::uniform_real_distribution<G4double> flat(0., 1.);
+  for (HistogramSet& copy : copies)
+    for (G4double& s : copy.sums) s = flat(engine);
+
+  G4cout << "HistogramSet: merge of " << sums.size()*sizeof(G4double)/1024 
+         << " kB per thread" << G4endl
+         << "  threads   merge [ms]" << G4endl;
+  std::vector<G4int> counts;
+  for (G4int n=1; n<maxThreads; n*=2) counts.push_back(n);
+  counts.push_back(maxThreads);
+  for (G4int n : counts) {
+    std::vector<HistogramSet> scratch(copies.begin(), copies.begin() + n);
+    std::vector<HistogramSet*> sets;
+    for (HistogramSet& s : scratch) sets.push_back(&s);
+    HistogramSet total(*this);
+    total.Reset();
+
+    G4Timer timer;
+    timer.Start();
+    total.Merge(sets, n);
+    timer.Stop();
+    G4cout << "  " << std::setw(7) << n << "   " << timer.GetRealElapsed()*1000. << G4endl;
+  }
+}
+
+
+void HistogramSet::Write(const G4String& file) const {
+
+  std::ofstream out(file.c_str());
+  out << "# histogram cell bin low sumw sumw2\n";
+  for (size_t id=0; id<histograms.size(); ++id) {
+    const Histogram& h = histograms[id];
+    for (G4int cell=0; cell<h.nCells; ++cell) {
+      for (G4int bin=0; bin<h.nBins+2; ++bin) {
+        size_t k = Index(id, cell, bin);
+        if (sums[k] == 0) continue;
+        G4double low = (bin == 0) ? -DBL_MAX : h.min + (bin - 1)/h.scale;
+        out << h.name << ' ' << cell << ' ' << bin << ' ' << low << ' ' 
+            << sums[k] << ' ' << sums[k+1] << '\n';
+      }
+    }
+  }
+}
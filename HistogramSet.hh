@@ -0,0 +1,81 @@
+#ifndef HistogramSet_h
+#define HistogramSet_h 1
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <vector>
+
+// Families of fixed-binning 1D histograms in one dense array, one
+// histogram per cell (tile, PMT, tile pair, ...). Every thread fills its own
+// set without locks; worker sets Register() themselves and the master
+// merges them at run end with a pairwise tree reduction, the pairs of each
+// level summed in parallel.
+//
+// Each bin holds the sum of weights and of squared weights. Bin 0 is the
+// underflow and bin nBins+1 the overflow.
+class HistogramSet {
+
+public:
+
+  HistogramSet() {}
+  ~HistogramSet();
+
+  // Returns the histogram id used by Fill()
+  G4int Book(const G4String& name, G4int nCells, G4int nBins, G4double min, G4double max);
+  G4bool IsBooked() const { return !histograms.empty(); }
+
+  inline void Fill(G4int id, G4int cell, G4double x, G4double w = 1.);
+
+  void Reset();
+  void Add(const HistogramSet& other);
+
+  // Sum sets into this one. The sets are used as scratch space and hold
+  // partial sums afterwards. At most nThreads pairs are added at a time.
+  void Merge(const std::vector<HistogramSet*>& sets, G4int nThreads);
+
+  // Worker sets waiting to be merged by the master
+  void Register();
+  static std::vector<HistogramSet*> GetRegistered();
+
+  // Time Merge() of maxThreads filled copies of this set for 1, 2, 4, ...
+  // threads and print the table
+  void BenchmarkMerge(G4int maxThreads) const;
+
+  G4int    GetNumberOfCells(G4int id) const { return histograms[id].nCells; }
+  G4int    GetNumberOfBins(G4int id) const { return histograms[id].nBins; }
+  G4double GetSumW(G4int id, G4int cell, G4int bin) const { return sums[Index(id, cell, bin)]; }
+  G4double GetSumW2(G4int id, G4int cell, G4int bin) const { return sums[Index(id, cell, bin) + 1]; }
+
+  // Non-empty bins as text: histogram, cell, bin, low edge, sum w, sum w2
+  void Write(const G4String& file) const;
+
+private:
+
+  struct Histogram {
+    G4String name;
+    G4int    nCells, nBins;
+    G4double min, max, scale;
+    size_t   offset;
+  };
+
+  size_t Index(G4int id, G4int cell, G4int bin) const {
+    const Histogram& h = histograms[id];
+    return h.offset + 2*((size_t)cell*(h.nBins + 2) + bin);
+  }
+
+  std::vector<Histogram> histograms;
+  std::vector<G4double>  sums;
+};
+
+
+inline void HistogramSet::Fill(G4int id, G4int cell, G4double x, G4double w) {
+
+  const Histogram& h = histograms[id];
+  G4int bin = (x < h.min) ? 0 : std::min(h.nBins + 1, 1 + (G4int)((x - h.min)*h.scale));
+  G4double* b = &sums[Index(id, cell, bin)];
+  b[0] += w;
+  b[1] += w*w;
+}
+
+#endif
@@ -0,0 +1,121 @@
+#include "HitReader.hh"
+#include "SparseCodec.hh"
+
+#include <cstring>
+
+#include <zlib.h>
+
+namespace {
+  const char     kMagic[8] = { 'C', 'R', 'H', 'I', 'T', 'S', 0, 2 };
+  const uint32_t kBlockTag = 0x4b4c4248;   // "HBLK"
+}
+
+
+HitReader::HitReader(const G4String& file)
+  : in(file.c_str(), std::ios::binary), nTiles(0), nWords(0), nPlanes(0),
+    nEvents(0), nHits(0) {
+
+  char magic[8];
+  uint32_t head[3];
+  if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(magic)) != 0 ||
+      !in.read(reinterpret_cast<char*>(head), sizeof(head))) {
+    G4Exception("HitReader::HitReader", "Output002", FatalException,
+                ("Not a sparse hit file: " + file).c_str());
+    return;
+  }
+  nTiles  = head[0];
+  nWords  = head[1];
+  nPlanes = head[2];
+  planeMasks.resize(nPlanes*nWords);
+  in.read(reinterpret_cast<char*>(planeMasks.data()), planeMasks.size()*sizeof(uint64_t));
+  for (G4int p=0; p<nPlanes; ++p) planeMaskPtrs.push_back(&planeMasks[p*nWords]);
+}
+
+
+G4bool HitReader::NextBlock() {
+
+  // Skip whatever is left of the current block's payload
+  if (!sizes.empty()) {
+    std::streamoff skip = 0;
+    for (size_t c=1; c<sizes.size(); c+=2) skip += sizes[c];
+    in.seekg(payloadStart + skip);
+  }
+  sizes.clear();
+  nEvents = nHits = 0;
+
+  uint32_t head[4];
+  if (!in.read(reinterpret_cast<char*>(head), sizeof(head))) return false;
+  if (head[0] != kBlockTag) {
+    G4Exception("HitReader::NextBlock", "Output003", FatalException, "Corrupt hit block");
+    return false;
+  }
+  nEvents = head[1];
+  nHits   = head[2];
+  masks.resize(nEvents*nWords);
+  sizes.resize(2*head[3]);
+  in.read(reinterpret_cast<char*>(masks.data()), masks.size()*sizeof(uint64_t));
+  in.read(reinterpret_cast<char*>(sizes.data()), sizes.size()*sizeof(uint32_t));
+  payloadStart = in.tellg();
+  return (bool)in;
+}
+
+
+G4bool HitReader::IsCoincidence(G4int i) const {
+  return SparseCodec::HitsAll(GetMask(i), planeMaskPtrs.data(), nPlanes, nWords);
+}
+
+
+void HitReader::LoadPayload(HitBlock& block) {
+
+  block.Clear();
+  block.event.resize(nEvents);
+  block.weight.resize(nEvents);
+  block.mask = masks;
+  block.edep.resize(nHits);
+  block.time.resize(nHits);
+
+  in.seekg(payloadStart);
+  ReadColumn(sizes[0], sizes[1], 4, block.event.data());
+  ReadColumn(sizes[2], sizes[3], 4, block.weight.data());
+  ReadColumn(sizes[4], sizes[5], 4, block.edep.data());
+  ReadColumn(sizes[6], sizes[7], 4, block.time.data());
+
+  hitOffset.resize(nEvents + 1);
+  hitOffset[0] = 0;
+  for (G4int i=0; i<nEvents; ++i) 
+    hitOffset[i+1] = hitOffset[i] + SparseCodec::Count(GetMask(i), nWords);
+}
+
+
+void HitReader::GetEvent(const HitBlock& block, G4int i, std::vector<float>& edep,
+                         std::vector<float>& time) const {
+
+  edep.resize(nTiles);
+  time.resize(nTiles);
+  SparseCodec::Decode(&block.mask[i*nWords], nTiles, &block.edep[hitOffset[i]],
+                      &block.time[hitOffset[i]], edep.data(), time.data());
+}
+
+
+void HitReader::ReadColumn(size_t raw, size_t stored, size_t width, void* data) {
+
+  packed.resize(stored);
+  in.read(packed.data(), stored);
+
+  shuffled.resize(raw);
+  uLongf size = raw;
+  // HitWriter stores a column raw unless compression makes it smaller
+  if (stored == raw) {
+    std::memcpy(shuffled.data(), packed.data(), raw);
+  } else if (uncompress(reinterpret_cast<Bytef*>(shuffled.data()), &size,
+                        reinterpret_cast<const Bytef*>(packed.data()), stored) != Z_OK || size != raw) {
+    G4Exception("HitReader::ReadColumn", "Output004", FatalException, "Cannot inflate hit column");
+    return;
+  }
+
+  // Undo the byte shuffle
+  char* out = static_cast<char*>(data);
+  size_t n = raw/width;
+  for (size_t b=0; b<width; ++b)
+    for (size_t i=0; i<n; ++i) out[i*width + b] = shuffled[b*n + i];
+}
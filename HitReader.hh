@@ -0,0 +1,62 @@
+#ifndef HitReader_h
+#define HitReader_h 1
+
+#include "HitWriter.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+// Reads the sparse hit files of HitWriter block by block. NextBlock() only
+// reads the tile masks; the compressed columns are inflated by
+// LoadPayload() on demand, so event selection on the masks, e.g.
+// IsCoincidence(), never touches the payloads of rejected blocks.
+class HitReader {
+
+public:
+
+  HitReader(const G4String& file);
+
+  G4int GetNumberOfTiles() const { return nTiles; }
+  G4int GetNumberOfPlanes() const { return nPlanes; }
+
+  // Advance to the next block; false at the end of the file
+  G4bool NextBlock();
+
+  G4int           GetNumberOfEvents() const { return nEvents; }
+  const uint64_t* GetMask(G4int i) const { return &masks[i*nWords]; }
+
+  // Event i has a hit in every plane of the file. Only built planes are
+  // written, so for a single-plane geometry any hit is a coincidence.
+  G4bool IsCoincidence(G4int i) const;
+
+  // Inflate the columns of the current block into block
+  void LoadPayload(HitBlock& block);
+
+  // Dense edep (MeV) and time (ns) over all tiles of event i of a loaded block
+  void GetEvent(const HitBlock& block, G4int i, std::vector<float>& edep,
+                std::vector<float>& time) const;
+
+private:
+
+  void ReadColumn(size_t raw, size_t stored, size_t width, void* data);
+
+  std::ifstream in;
+  G4int nTiles;
+  G4int nWords;
+  G4int nPlanes;
+  std::vector<uint64_t> planeMasks;
+  std::vector<const uint64_t*> planeMaskPtrs;
+
+  G4int                 nEvents;
+  G4int                 nHits;
+  std::vector<uint64_t> masks;
+  std::vector<uint32_t> sizes;
+  std::streampos        payloadStart;
+  std::vector<G4int>    hitOffset;
+  std::vector<char>     packed;
+  std::vector<char>     shuffled;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#include "HitWriter.hh"
+#include "SparseCodec.hh"
+
+#include "G4AutoLock.hh"
+
+#include <chrono>
+#include <cstring>
+#include <map>
+
+#include <zlib.h>
+
+namespace {
+  const char     kMagic[8]  = { 'C', 'R', 'H', 'I', 'T', 'S', 0, 2 };
+  const uint32_t kBlockTag  = 0x4b4c4248;   // "HBLK"
+  const size_t   kQueueSize = 64;
+
+  G4Mutex writerMutex = G4MUTEX_INITIALIZER;
+  std::map<G4String, std::weak_ptr<HitWriter> > openWriters;
+}
+
+
+void HitBlock::Clear() {
+  event.clear();
+  weight.clear();
+  mask.clear();
+  edep.clear();
+  time.clear();
+}
+
+
+std::shared_ptr<HitWriter> HitWriter::Open(const G4String& file, G4int nTiles,
+                                           const std::vector<uint64_t>& planeMasks) {
+
+  G4AutoLock lock(&writerMutex);
+  std::shared_ptr<HitWriter> writer = openWriters[file].lock();
+  if (!writer) {
+    writer.reset(new HitWriter(file, nTiles, planeMasks));
+    openWriters[file] = writer;
+  }
+  return writer;
+}
+
+
+HitWriter::HitWriter(const G4String& file, G4int nTiles,
+                     const std::vector<uint64_t>& planeMasks)
+  : fileName(file), filled(kQueueSize), empty(kQueueSize), stopping(false) {
+
+  out.open(file.c_str(), std::ios::binary | std::ios::trunc);
+  if (!out) {
+    G4Exception("HitWriter::HitWriter", "Output001", FatalException,
+                ("Cannot open hit output " + file).c_str());
+    return;
+  }
+  uint32_t head[3] = { (uint32_t)nTiles, (uint32_t)SparseCodec::Words(nTiles), 
+                       (uint32_t)(planeMasks.size()/SparseCodec::Words(nTiles)) };
+  out.write(kMagic, sizeof(kMagic));
+  out.write(reinterpret_cast<const char*>(head), sizeof(head));
+  out.write(reinterpret_cast<const char*>(planeMasks.data()), planeMasks.size()*sizeof(uint64_t));
+
+  writer = std::thread(&HitWriter::Run, this);
+}
+
+
+HitWriter::~HitWriter() {
+
+  stopping = true;
+  if (writer.joinable()) writer.join();
+
+  HitBlock* block;
+  while (empty.TryPop(block)) delete block;
+  out.close();
+  G4cout << "HitWriter: closed " << fileName << G4endl;
+}
+
+
+HitBlock* HitWriter::Acquire() {
+
+  HitBlock* block;
+  if (empty.TryPop(block)) return block;
+  return new HitBlock;
+}
+
+
+void HitWriter::Submit(HitBlock* block) {
+
+  // Only waits if the writer is a full queue behind
+  while (!filled.TryPush(std::move(block))) std::this_thread::yield();
+}
+
+
+void HitWriter::Run() {
+
+  HitBlock* block;
+  for (;;) {
+    if (filled.TryPop(block)) {
+      WriteBlock(*block);
+      block->Clear();
+      if (!empty.TryPush(std::move(block))) delete block;
+    } else if (stopping) {
+      if (!filled.TryPop(block)) break;
+      WriteBlock(*block);
+      delete block;
+    } else {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  out.flush();
+}
+
+
+void HitWriter::WriteBlock(const HitBlock& block) {
+
+  if (block.Events() == 0) return;
+
+  std::vector<uint32_t> sizes;
+  std::vector<char>     payload;
+  WriteColumn(block.event.data(),  4*block.Events(), 4, sizes, payload);
+  WriteColumn(block.weight.data(), 4*block.Events(), 4, sizes, payload);
+  WriteColumn(block.edep.data(),   4*block.Hits(),   4, sizes, payload);
+  WriteColumn(block.time.data(),   4*block.Hits(),   4, sizes, payload);
+
+  uint32_t head[4] = { kBlockTag, (uint32_t)block.Events(), (uint32_t)block.Hits(),
+                       (uint32_t)(sizes.size()/2) };
+  out.write(reinterpret_cast<const char*>(head), sizeof(head));
+  out.write(reinterpret_cast<const char*>(block.mask.data()), block.mask.size()*sizeof(uint64_t));
+  out.write(reinterpret_cast<const char*>(sizes.data()), sizes.size()*sizeof(uint32_t));
+  out.write(payload.data(), payload.size());
+}
+
+
+void HitWriter::WriteColumn(const void* data, size_t bytes, size_t width,
+                            std::vector<uint32_t>& sizes, std::vector<char>& payload) {
+
+  // Byte shuffle: all first bytes, then all second bytes, ...
+  const char* in = static_cast<const char*>(data);
+  size_t n = bytes/width;
+  shuffled.resize(bytes);
+  for (size_t b=0; b<width; ++b) 
+    for (size_t i=0; i<n; ++i) shuffled[b*n + i] = in[i*width + b];
+
+  // Columns that do not shrink are stored raw, so stored == raw size always
+  // means an uncompressed column to the reader
+  uLongf stored = compressBound(bytes);
+  size_t start = payload.size();
+  payload.resize(start + stored);
+  if (compress2(reinterpret_cast<Bytef*>(&payload[start]), &stored,
+                reinterpret_cast<const Bytef*>(shuffled.data()), bytes, 1) != Z_OK || stored >= bytes) {
+    std::memcpy(&payload[start], shuffled.data(), bytes);
+    stored = bytes;
+  }
+  payload.resize(start + stored);
+  sizes.push_back(bytes);
+  sizes.push_back(stored);
+}
@@ -0,0 +1,79 @@
+#ifndef HitWriter_h
+#define HitWriter_h 1
+
+#include "BoundedQueue.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Sparse per-event tile summaries, kept column by column. Each event has a
+// tile mask (SparseCodec::Words() words) and its hit tiles' edep and time
+// packed in tile order.
+struct HitBlock {
+  std::vector<int32_t>  event;
+  std::vector<float>    weight;
+  std::vector<uint64_t> mask;
+  std::vector<float>    edep;
+  std::vector<float>    time;
+
+  size_t Events() const { return event.size(); }
+  size_t Hits()   const { return edep.size(); }
+  void   Clear();
+};
+
+// Columnar hit file written by a dedicated thread. Workers fill HitBlocks
+// and Submit() them through a lock-free queue; the writer thread
+// compresses and writes them and hands the emptied blocks back through a
+// second queue, so event processing never waits on the disk.
+//
+// File layout: "CRHITS" magic, uint32 number of tiles, uint32 mask words,
+// uint32 number of planes, the uint64 tile mask of each plane, then blocks of
+//   uint32 'HBLK', uint32 events, uint32 hits, uint32 columns,
+//   uint64 tile masks, mask words per event, uncompressed,
+//   per column uint32 raw bytes and uint32 stored bytes,
+//   the column payloads,
+// each payload being the byte-shuffled column deflated with zlib (stored
+// as is when the stored size equals the raw size). The masks come first so
+// that a reader can select events, e.g. plane coincidences, and skip the
+// payloads of blocks without any.
+// Columns: event int32 and weight float32 per event, edep float32 MeV and
+// time float32 ns per hit.
+class HitWriter {
+
+public:
+
+  // planeMasks holds the tile mask of each plane, back to back
+  static std::shared_ptr<HitWriter> Open(const G4String& file, G4int nTiles,
+                                         const std::vector<uint64_t>& planeMasks);
+
+  ~HitWriter();
+
+  HitBlock* Acquire();
+  void      Submit(HitBlock* block);
+
+  size_t GetQueueDepth() const { return filled.Size(); }
+
+private:
+
+  HitWriter(const G4String& file, G4int nTiles, const std::vector<uint64_t>& planeMasks);
+
+  void Run();
+  void WriteBlock(const HitBlock& block);
+  void WriteColumn(const void* data, size_t bytes, size_t width,
+                   std::vector<uint32_t>& sizes, std::vector<char>& payload);
+
+  G4String                  fileName;
+  std::ofstream             out;
+  BoundedQueue<HitBlock*>   filled;
+  BoundedQueue<HitBlock*>   empty;
+  std::atomic<G4bool>       stopping;
+  std::thread               writer;
+  std::vector<char>         shuffled;
+};
+
+#endif
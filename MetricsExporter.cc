@@ -0,0 +1,161 @@
+#include "MetricsExporter.hh"
+
+#include "G4AutoLock.hh"
+#include "G4Threading.hh"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+
+#include <unistd.h>
+
+namespace {
+  G4Mutex metricsMutex = G4MUTEX_INITIALIZER;
+  std::map<G4int, std::unique_ptr<MetricsExporter::ThreadCounters> > threadCounters;
+  std::map<G4String, std::function<G4double()> > gauges;
+  std::map<G4String, std::weak_ptr<MetricsExporter> > openExporters;
+
+  const char* planeNames[kNumPlanes] = { "bottom", "top" };
+}
+
+
+G4double MetricsExporter::ResidentBytes() {
+
+  long pages = 0, resident = 0;
+  FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (!statm) return -1;
+  if (std::fscanf(statm, "%ld %ld", &pages, &resident) != 2) resident = -1;
+  std::fclose(statm);
+  return resident < 0 ? -1 : (G4double)resident*sysconf(_SC_PAGESIZE);
+}
+
+
+MetricsExporter::ThreadCounters* MetricsExporter::GetThreadCounters() {
+
+  G4int thread = G4Threading::G4GetThreadId();
+  G4AutoLock lock(&metricsMutex);
+  std::unique_ptr<ThreadCounters>& counters = threadCounters[thread];
+  if (!counters) {
+    counters.reset(new ThreadCounters);
+    counters->thread = thread;
+    counters->events = 0;
+    counters->steps = 0;
+    for (G4int p=0; p<kNumPlanes; ++p) counters->planeHits[p] = 0;
+  }
+  return counters.get();
+}
+
+
+void MetricsExporter::SetGauge(const G4String& name, std::function<G4double()> gauge) {
+
+  G4AutoLock lock(&metricsMutex);
+  gauges[name] = gauge;
+}
+
+
+void MetricsExporter::RemoveGauge(const G4String& name) {
+
+  G4AutoLock lock(&metricsMutex);
+  gauges.erase(name);
+}
+
+
+std::shared_ptr<MetricsExporter> MetricsExporter::Open(const G4String& file, G4double interval) {
+
+  G4AutoLock lock(&metricsMutex);
+  std::shared_ptr<MetricsExporter> exporter = openExporters[file].lock();
+  if (!exporter) {
+    exporter.reset(new MetricsExporter(file, interval));
+    openExporters[file] = exporter;
+  }
+  return exporter;
+}
+
+
+MetricsExporter::MetricsExporter(const G4String& file, G4double seconds)
+  : fileName(file), interval(seconds), stopping(false), lastWrite(Clock::now()) {
+
+  for (G4int p=0; p<kNumPlanes; ++p) lastPlaneHits[p] = 0;
+  writer = std::thread(&MetricsExporter::Run, this);
+}
+
+
+MetricsExporter::~MetricsExporter() {
+
+  stopping = true;
+  if (writer.joinable()) writer.join();
+}
+
+
+void MetricsExporter::Run() {
+
+  Write();
+  while (!stopping) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (std::chrono::duration<G4double>(Clock::now() - lastWrite).count() >= interval) Write();
+  }
+  Write();
+}
+
+
+void MetricsExporter::Write() {
+
+  Clock::time_point now = Clock::now();
+  G4double dt = std::chrono::duration<G4double>(now - lastWrite).count();
+  G4double rate = (dt > 0) ? 1./dt : 0.;
+  lastWrite = now;
+
+  G4String tmpName = fileName + ".tmp";
+  std::ofstream out(tmpName.c_str(), std::ios::trunc);
+  {
+    G4AutoLock lock(&metricsMutex);
+
+    // Counters are kept per thread id, rates come from the previous write
+    uint64_t totalHits[kNumPlanes] = { 0, 0 };
+    out << "# HELP cosmic_events_total Events processed per thread\n"
+        << "# TYPE cosmic_events_total counter\n";
+    for (const auto& entry : threadCounters) 
+      out << "cosmic_events_total{thread=\"" << entry.first << "\"} " << entry.second->events << "\n";
+
+    out << "# HELP cosmic_events_per_second Event rate per thread since the previous update\n"
+        << "# TYPE cosmic_events_per_second gauge\n";
+    for (const auto& entry : threadCounters) {
+      uint64_t events = entry.second->events;
+      out << "cosmic_events_per_second{thread=\"" << entry.first << "\"} " 
+          << (events - lastEvents[entry.first])*rate << "\n";
+      lastEvents[entry.first] = events;
+    }
+
+    out << "# HELP cosmic_steps_per_second Step rate per thread since the previous update\n"
+        << "# TYPE cosmic_steps_per_second gauge\n";
+    for (const auto& entry : threadCounters) {
+      uint64_t steps = entry.second->steps;
+      out << "cosmic_steps_per_second{thread=\"" << entry.first << "\"} " 
+          << (steps - lastSteps[entry.first])*rate << "\n";
+      lastSteps[entry.first] = steps;
+      for (G4int p=0; p<kNumPlanes; ++p) totalHits[p] += entry.second->planeHits[p];
+    }
+
+    out << "# HELP cosmic_plane_hits_per_second Events with a hit in the plane, per second\n"
+        << "# TYPE cosmic_plane_hits_per_second gauge\n";
+    for (G4int p=0; p<kNumPlanes; ++p) {
+      out << "cosmic_plane_hits_per_second{plane=\"" << planeNames[p] << "\"} "
+          << (totalHits[p] - lastPlaneHits[p])*rate << "\n";
+      lastPlaneHits[p] = totalHits[p];
+    }
+
+    for (const auto& gauge : gauges) {
+      G4double value = gauge.second();
+      if (value >= 0) out << "# TYPE " << gauge.first << " gauge\n" << gauge.first << " " << value << "\n";
+    }
+  }
+
+  G4double rss = ResidentBytes();
+  if (rss >= 0) {
+    out << "# HELP cosmic_resident_memory_bytes Resident set size\n"
+        << "# TYPE cosmic_resident_memory_bytes gauge\n"
+        << "cosmic_resident_memory_bytes " << (uint64_t)rss << "\n";
+  }
+  out.close();
+  std::rename(tmpName.c_str(), fileName.c_str());
+}
@@ -0,0 +1,73 @@
+#ifndef MetricsExporter_h
+#define MetricsExporter_h 1
+
+#include "TileInfo.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+
+// Periodic metrics file in the Prometheus text format, for a node exporter
+// textfile collector. A background thread rewrites the file every
+// interval through a temporary file and rename(), so readers never see a
+// partial file.
+//
+// Event-loop threads count into their own ThreadCounters with relaxed
+// atomic stores, which cost about as much as a plain increment; output
+// queues and other sources are polled through named gauges.
+class MetricsExporter {
+
+public:
+
+  struct ThreadCounters {
+    G4int                 thread;
+    std::atomic<uint64_t> events;
+    std::atomic<uint64_t> steps;
+    std::atomic<uint64_t> planeHits[kNumPlanes];
+
+    static void Increment(std::atomic<uint64_t>& counter) {
+      counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+  };
+
+  // Counters of the calling thread, created on first use and kept for the
+  // lifetime of the program
+  static ThreadCounters* GetThreadCounters();
+
+  // Polled by the exporter thread; a gauge returning a negative value is
+  // skipped
+  static void SetGauge(const G4String& name, std::function<G4double()> gauge);
+  static void RemoveGauge(const G4String& name);
+
+  static std::shared_ptr<MetricsExporter> Open(const G4String& file, G4double interval);
+
+  // Resident set size of the process from /proc/self/statm, -1 if unknown
+  static G4double ResidentBytes();
+
+  ~MetricsExporter();
+
+private:
+
+  typedef std::chrono::steady_clock Clock;
+
+  MetricsExporter(const G4String& file, G4double interval);
+
+  void Run();
+  void Write();
+
+  G4String             fileName;
+  G4double             interval;
+  std::atomic<G4bool>  stopping;
+  std::thread          writer;
+
+  Clock::time_point     lastWrite;
+  std::map<G4int, uint64_t> lastEvents, lastSteps;
+  uint64_t              lastPlaneHits[kNumPlanes];
+};
+
+#endif
@@ -0,0 +1,182 @@
+#include "PerfCounters.hh"
+
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+  std::atomic<G4bool> perfEnabled(false);
+  G4Mutex registryMutex = G4MUTEX_INITIALIZER;
+  std::vector<PerfCounters*> registry;
+
+  const char* counterNames[PerfCounters::kNumCounters] = 
+    { "cycles", "instructions", "cache misses", "branch misses" };
+  const char* typeNames[PerfCounters::kNumEventTypes] = 
+    { "coincidence", "no coincidence", "aborted" };
+  const uint64_t kMissing = ~(uint64_t)0;
+}
+
+
+void PerfCounters::Sample::Clear() {
+  std::fill(value, value + kNumCounters, 0);
+  wallTime = 0;
+  count = 0;
+}
+
+
+void PerfCounters::Sample::Add(const Sample& other) {
+  for (G4int c=0; c<kNumCounters; ++c) 
+    value[c] = (value[c] == kMissing || other.value[c] == kMissing) ? kMissing : value[c] + other.value[c];
+  wallTime += other.wallTime;
+  count += other.count;
+}
+
+
+PerfCounters::PerfCounters() : opened(false), available(false) {
+
+  std::fill(fd, fd + kNumCounters, -1);
+  for (G4int t=0; t<kNumEventTypes; ++t) totals[t].Clear();
+
+  G4AutoLock lock(&registryMutex);
+  registry.push_back(this);
+}
+
+
+PerfCounters::~PerfCounters() {
+
+#ifdef __linux__
+  for (G4int c=0; c<kNumCounters; ++c) if (fd[c] >= 0) close(fd[c]);
+#endif
+  G4AutoLock lock(&registryMutex);
+  registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+}
+
+
+void PerfCounters::SetEnabled(G4bool val) { perfEnabled = val; }
+G4bool PerfCounters::IsEnabled() { return perfEnabled; }
+
+
+G4bool PerfCounters::Open() {
+
+  opened = true;
+#ifdef __linux__
+  const uint64_t config[kNumCounters] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                          PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+  for (G4int c=0; c<kNumCounters; ++c) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = config[c];
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    fd[c] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd[c] >= 0) available = true;
+  }
+  if (!available) {
+    G4Exception("PerfCounters::Open", "Perf001", JustWarning,
+                "perf_event_open refused all hardware counters (see kernel.perf_event_paranoid)");
+  }
+#else
+  G4Exception("PerfCounters::Open", "Perf001", JustWarning,
+              "Hardware counters need perf_event_open (Linux)");
+#endif
+  return available;
+}
+
+
+G4bool PerfCounters::Read(uint64_t* values) const {
+
+#ifdef __linux__
+  for (G4int c=0; c<kNumCounters; ++c) {
+    values[c] = kMissing;
+    if (fd[c] >= 0 && read(fd[c], &values[c], sizeof(uint64_t)) != sizeof(uint64_t)) 
+      values[c] = kMissing;
+  }
+  return true;
+#else
+  (void)values;
+  return false;
+#endif
+}
+
+
+G4bool PerfCounters::Start() {
+
+  if (!perfEnabled) return false;
+  if (!opened) Open();
+  if (!available) return false;
+
+  Read(startValues);
+  startTime = Clock::now();
+  return true;
+}
+
+
+G4bool PerfCounters::Stop(Sample& delta) {
+
+  if (!available) return false;
+
+  uint64_t values[kNumCounters];
+  Read(values);
+  for (G4int c=0; c<kNumCounters; ++c) 
+    delta.value[c] = (values[c] == kMissing || startValues[c] == kMissing) ? kMissing : values[c] - startValues[c];
+  delta.wallTime = std::chrono::duration<G4double>(Clock::now() - startTime).count();
+  delta.count = 1;
+  return true;
+}
+
+
+void PerfCounters::Print(const G4String& label, const Sample& sample) {
+
+  G4cout << "  " << std::left << std::setw(16) << label << std::right << std::setw(10) << sample.count
+         << std::setw(12) << std::setprecision(4) 
+         << (sample.wallTime > 0 ? sample.count/sample.wallTime : 0.);
+  for (G4int c=0; c<kNumCounters; ++c) {
+    if (sample.value[c] == kMissing) G4cout << std::setw(14) << "-";
+    else G4cout << std::setw(14) << (G4double)sample.value[c]/std::max(sample.count, 1);
+  }
+  const uint64_t* v = sample.value;
+  G4cout << std::setw(8) << ((v[kCycles] != kMissing && v[kInstructions] != kMissing && v[kCycles] > 0)
+                             ? (G4double)v[kInstructions]/v[kCycles] : 0.) << G4endl;
+}
+
+
+void PerfCounters::Report() {
+
+  Sample merged[kNumEventTypes];
+  for (G4int t=0; t<kNumEventTypes; ++t) merged[t].Clear();
+  {
+    G4AutoLock lock(&registryMutex);
+    for (PerfCounters* counters : registry) {
+      for (G4int t=0; t<kNumEventTypes; ++t) {
+        merged[t].Add(counters->totals[t]);
+        counters->totals[t].Clear();
+      }
+    }
+  }
+
+  G4int nEvents = 0;
+  for (G4int t=0; t<kNumEventTypes; ++t) nEvents += merged[t].count;
+  if (nEvents == 0) return;
+
+  // Throughput is per thread: events over the wall time spent inside them
+  G4cout << "PerfCounters: per event, user space" << G4endl
+         << "  " << std::left << std::setw(16) << "event type" << std::right << std::setw(10) << "events"
+         << std::setw(12) << "events/s";
+  for (G4int c=0; c<kNumCounters; ++c) G4cout << std::setw(14) << counterNames[c];
+  G4cout << std::setw(8) << "IPC" << G4endl;
+  for (G4int t=0; t<kNumEventTypes; ++t) 
+    if (merged[t].count > 0) Print(typeNames[t], merged[t]);
+}
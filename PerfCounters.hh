@@ -0,0 +1,66 @@
+#ifndef PerfCounters_h
+#define PerfCounters_h 1
+
+#include "globals.hh"
+
+#include <chrono>
+#include <cstdint>
+
+// Hardware counters of the calling thread through perf_event_open (Linux
+// only): cycles, instructions, cache misses and branch misses, user space
+// only. Counters the kernel refuses are reported as missing; without any
+// Start() returns false and nothing is counted. Switched on for all
+// threads with SetEnabled().
+//
+// Each event-loop thread keeps totals per event type; the master merges
+// them at run end and prints them with the event throughput.
+class PerfCounters {
+
+public:
+
+  enum Counter   { kCycles = 0, kInstructions, kCacheMisses, kBranchMisses, kNumCounters };
+  enum EventType { kTriggered = 0, kNotTriggered, kAborted, kNumEventTypes };
+
+  struct Sample {
+    uint64_t value[kNumCounters];
+    G4double wallTime;
+    G4int    count;
+    void Clear();
+    void Add(const Sample& other);
+  };
+
+  PerfCounters();
+  ~PerfCounters();
+
+  static void   SetEnabled(G4bool val);
+  static G4bool IsEnabled();
+
+  // Counters are opened on the first Start() of the calling thread
+  G4bool Start();
+  G4bool Stop(Sample& delta);
+
+  // Add to the totals of one event type
+  void Accumulate(G4int type, const Sample& delta) { totals[type].Add(delta); }
+
+  static void Print(const G4String& label, const Sample& sample);
+
+  // Merge and print the per-type totals of all threads, then clear them
+  static void Report();
+
+private:
+
+  typedef std::chrono::steady_clock Clock;
+
+  G4bool Open();
+  G4bool Read(uint64_t* values) const;
+
+  G4int             fd[kNumCounters];
+  G4bool            opened;
+  G4bool            available;
+  uint64_t          startValues[kNumCounters];
+  Clock::time_point startTime;
+
+  Sample totals[kNumEventTypes];
+};
+
+#endif
@@ -0,0 +1,429 @@
+#include "PrimaryGeneratorAction.hh"
+#include "DetectorConstruction.hh"
+#include "MetricsExporter.hh"
+#include "PrimaryLibrary.hh"
+#include "ShowerReader.hh"
+
+#include "G4Event.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4MuonMinus.hh"
+#include "G4MuonPlus.hh"
+#include "G4ParticleTable.hh"
+#include "G4Threading.hh"
+#include "G4GenericMessenger.hh"
+#include "Randomize.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+PrimaryGeneratorAction::PrimaryGeneratorAction(const DetectorConstruction* det)
+  : G4VUserPrimaryGeneratorAction(), detector(det), tableVersion(-1), startHeight(0), planeArea(0),
+    zenithExponent(2.), spectralIndex(2.7), eMin(1.*CLHEP::GeV), eMax(1.*CLHEP::TeV),
+    intensity(70.), muPlusFraction(1.27/2.27), slice(0), sliceBegin(0), 
+    sliceEnd(0), cursor(0), showerMargin(1.*CLHEP::m) {
+
+  messenger = new G4GenericMessenger(this, "/cosmic/gun/", "Cosmic muons within the detector acceptance");
+  messenger->DeclareProperty("zenithExponent", zenithExponent, "n in I(theta) = I0 cos^n(theta)");
+  messenger->DeclareProperty("spectralIndex", spectralIndex, "gamma in dN/dE ~ E^-gamma");
+  messenger->DeclarePropertyWithUnit("eMin", "GeV", eMin, "Lower edge of the energy spectrum");
+  messenger->DeclarePropertyWithUnit("eMax", "GeV", eMax, "Upper edge of the energy spectrum");
+  messenger->DeclareProperty("intensity", intensity, 
+                             "Vertical intensity I0 in eMin..eMax, per m2 s sr");
+  messenger->DeclareProperty("muPlusFraction", muPlusFraction, "Fraction of mu+");
+  messenger->DeclareProperty("library", libraryFile, 
+                             "Read primaries from a pre-generated library file instead");
+  messenger->DeclareProperty("showerFile", showerFile,
+                             "Stream external air showers (.csv or binary) instead");
+  messenger->DeclarePropertyWithUnit("showerMargin", "m", showerMargin,
+                                     "Keep shower particles this far around the tile footprint");
+  messenger->DeclareProperty("replay", replayFile,
+                             "Re-simulate the event of a slow event record, empty for normal running");
+  messenger->DeclareMethod("writeLibrary", &PrimaryGeneratorAction::WriteLibrary,
+                           "<file> <n>: write n generated primaries as a primary library");
+}
+
+
+PrimaryGeneratorAction::~PrimaryGeneratorAction() {
+  delete messenger;
+}
+
+
+void PrimaryGeneratorAction::BuildPairTable() {
+
+  const std::vector<TileInfo>& tiles = detector->GetTiles();
+  tableVersion = detector->GetTableVersion();
+  topTiles.clear();
+  bottomTiles.clear();
+  for (const TileInfo& tile : tiles) {
+    if (tile.plane == kTopPlane) topTiles.push_back(tile.id);
+    else                         bottomTiles.push_back(tile.id);
+  }
+
+  startHeight = detector->GetDetectorMax().z() + 1.*CLHEP::cm;
+
+  // With a single plane built the table picks tiles by area
+  if (topTiles.empty() || bottomTiles.empty()) {
+    const std::vector<G4int>& plane = topTiles.empty() ? bottomTiles : topTiles;
+    pairProb.clear();
+    pairCdf.assign(plane.size(), 0.);
+    planeArea = 0;
+    for (size_t i=0; i<plane.size(); ++i) {
+      planeArea += Area(tiles[plane[i]]);
+      pairCdf[i] = planeArea;
+    }
+    for (G4double& c : pairCdf) c /= planeArea;
+    return;
+  }
+
+  // Bound by the same memory limit as the detector's tile-pair table
+  pairProb.clear();
+  pairCdf.clear();
+  if (!detector->HasPairTable()) return;
+
+  // Centre to centre acceptance guess, only used to pick pairs
+  pairProb.assign(topTiles.size()*bottomTiles.size(), 0.);
+  pairCdf.assign(pairProb.size(), 0.);
+  G4double sum = 0;
+  for (size_t i=0; i<topTiles.size(); ++i) {
+    const TileInfo& top = tiles[topTiles[i]];
+    for (size_t j=0; j<bottomTiles.size(); ++j) {
+      const TileInfo& bottom = tiles[bottomTiles[j]];
+      G4ThreeVector d = top.centre - bottom.centre;
+      G4double cost = std::fabs(d.z())/d.mag();
+      G4double p = Area(top)*Area(bottom)*std::pow(cost, zenithExponent + 2)/d.mag2();
+      pairProb[i*bottomTiles.size() + j] = p;
+      sum += p;
+      pairCdf[i*bottomTiles.size() + j] = sum;
+    }
+  }
+  for (size_t k=0; k<pairProb.size(); ++k) {
+    pairProb[k] /= sum;
+    pairCdf[k]  /= sum;
+  }
+}
+
+
+void PrimaryGeneratorAction::GeneratePrimaries(G4Event* event) {
+
+  if (!replayFile.empty()) Replay(event);
+  else                     Generate(event);
+}
+
+
+void PrimaryGeneratorAction::WriteLibrary(const G4String& args) {
+
+  // Broadcast to every worker; the first one, or the sequential run, writes
+  if (G4Threading::G4GetThreadId() > 0) return;
+  std::istringstream in(args);
+  std::string file;
+  G4long n = 0;
+  if (!(in >> file >> n) || n <= 0) {
+    G4Exception("PrimaryGeneratorAction::WriteLibrary", "Library012", JustWarning,
+                "Usage: writeLibrary <file> <n>");
+    return;
+  }
+  if (!libraryFile.empty() || !showerFile.empty()) {
+    G4Exception("PrimaryGeneratorAction::WriteLibrary", "Library013", JustWarning,
+                "Library and shower input are not written to a library");
+    return;
+  }
+
+  std::vector<PrimaryLibrary::Entry> entries;
+  entries.reserve(n);
+  while ((G4long)entries.size() < n) {
+    G4Event scratch;
+    Generate(&scratch);
+    if (scratch.GetNumberOfPrimaryVertex() == 0) return;
+    const G4PrimaryVertex*   vertex   = scratch.GetPrimaryVertex();
+    const G4PrimaryParticle* particle = vertex->GetPrimary();
+    PrimaryLibrary::Entry entry;
+    entry.position  = vertex->GetPosition();
+    entry.direction = particle->GetMomentumDirection();
+    entry.energy    = particle->GetKineticEnergy();
+    entry.weight    = vertex->GetWeight();
+    entry.pdg       = particle->GetPDGcode();
+    entries.push_back(entry);
+  }
+  PrimaryLibrary::Write(file, entries);
+  G4cout << "PrimaryGeneratorAction: " << n << " primaries written to " << file << G4endl;
+}
+
+
+void PrimaryGeneratorAction::Replay(G4Event* event) {
+
+  std::ifstream in(replayFile.c_str());
+  std::string line;
+  std::vector<std::string> primaries;
+  while (std::getline(in, line) && line != "engine") primaries.push_back(line);
+  if (!in) {
+    G4Exception("PrimaryGeneratorAction::Replay", "Replay001", RunMustBeAborted,
+                ("No engine state in " + replayFile).c_str());
+    return;
+  }
+
+  // Back to the state the event started from. Generating as the original run
+  // did consumes the same random numbers; the result is then replaced by the
+  // recorded primaries, which also covers library and shower input.
+  G4Random::restoreFullState(in);
+  G4Event scratch;
+  Generate(&scratch);
+
+  G4ParticleTable* table = G4ParticleTable::GetParticleTable();
+  G4PrimaryVertex* vertex = 0;
+  for (const std::string& record : primaries) {
+    std::istringstream fields(record);
+    std::string tag;
+    fields >> tag;
+    if (tag == "vertex") {
+      G4double x, y, z, t, w;
+      fields >> x >> y >> z >> t >> w;
+      vertex = new G4PrimaryVertex(x, y, z, t);
+      vertex->SetWeight(w);
+      event->AddPrimaryVertex(vertex);
+    } else if (tag == "particle" && vertex) {
+      G4int pdg;
+      G4double px, py, pz;
+      fields >> pdg >> px >> py >> pz;
+      G4ParticleDefinition* definition = table->FindParticle(pdg);
+      if (definition) vertex->SetPrimary(new G4PrimaryParticle(definition, px, py, pz));
+    }
+  }
+}
+
+
+void PrimaryGeneratorAction::Generate(G4Event* event) {
+
+  if (!libraryFile.empty()) {
+    GenerateFromLibrary(event);
+    return;
+  }
+  if (!showerFile.empty()) {
+    GenerateFromShowers(event);
+    return;
+  }
+
+  if (tableVersion != detector->GetTableVersion()) BuildPairTable();
+  if (topTiles.empty() || bottomTiles.empty()) {
+    GenerateSinglePlane(event);
+    return;
+  }
+  if (pairCdf.empty()) {
+    G4Exception("PrimaryGeneratorAction::Generate", "Gun001", RunMustBeAborted,
+                "Layout too large for a tile-pair table, use a primary library or showers");
+    return;
+  }
+
+  const std::vector<TileInfo>& tiles = detector->GetTiles();
+  size_t k = std::upper_bound(pairCdf.begin(), pairCdf.end(), G4UniformRand()) - pairCdf.begin();
+  k = std::min(k, pairCdf.size() - 1);
+  const TileInfo& top    = tiles[topTiles[k/bottomTiles.size()]];
+  const TileInfo& bottom = tiles[bottomTiles[k % bottomTiles.size()]];
+
+  G4ThreeVector p1 = SamplePoint(top);
+  G4ThreeVector p2 = SamplePoint(bottom);
+  G4ThreeVector dir = (p2 - p1).unit();
+  if (dir.z() >= 0) dir = -dir;
+  G4double cost = -dir.z();
+
+  // Sum the sampling density of this line over every pair it crosses
+  std::vector<G4ThreeVector> topHits(topTiles.size()), bottomHits(bottomTiles.size());
+  std::vector<G4bool> topCrossed(topTiles.size()), bottomCrossed(bottomTiles.size());
+  for (size_t i=0; i<topTiles.size(); ++i) 
+    topCrossed[i] = Crosses(tiles[topTiles[i]], p1, dir, topHits[i]);
+  for (size_t j=0; j<bottomTiles.size(); ++j)
+    bottomCrossed[j] = Crosses(tiles[bottomTiles[j]], p1, dir, bottomHits[j]);
+
+  G4double density = 0;
+  for (size_t i=0; i<topTiles.size(); ++i) {
+    if (!topCrossed[i]) continue;
+    for (size_t j=0; j<bottomTiles.size(); ++j) {
+      if (!bottomCrossed[j]) continue;
+      G4double r2 = (topHits[i] - bottomHits[j]).mag2();
+      density += pairProb[i*bottomTiles.size() + j]*r2
+        /(Area(tiles[topTiles[i]])*Area(tiles[bottomTiles[j]])*cost*cost);
+    }
+  }
+  G4double weight = (density > 0) 
+    ? intensity/(CLHEP::m2*CLHEP::sr)*std::pow(cost, zenithExponent)/density : 0;
+
+  G4ThreeVector start = p1 + ((startHeight - p1.z())/dir.z())*dir;
+
+  G4ParticleDefinition* muon = (G4UniformRand() < muPlusFraction) 
+    ? G4MuonPlus::Definition() : G4MuonMinus::Definition();
+  G4PrimaryParticle* particle = new G4PrimaryParticle(muon);
+  particle->SetKineticEnergy(SampleEnergy());
+  particle->SetMomentumDirection(dir);
+
+  G4PrimaryVertex* vertex = new G4PrimaryVertex(start, 0.);
+  vertex->SetPrimary(particle);
+  vertex->SetWeight(weight);
+  event->AddPrimaryVertex(vertex);
+}
+
+
+void PrimaryGeneratorAction::GenerateSinglePlane(G4Event* event) {
+
+  // A tile by area, a point on it and cos(theta) from cos^(n+1), the flux
+  // through a horizontal surface. The weight is then I0 A 2pi/(n+2) over
+  // the number of tiles the line crosses.
+  const std::vector<TileInfo>& tiles = detector->GetTiles();
+  const std::vector<G4int>& plane = topTiles.empty() ? bottomTiles : topTiles;
+  size_t k = std::upper_bound(pairCdf.begin(), pairCdf.end(), G4UniformRand()) - pairCdf.begin();
+  k = std::min(k, pairCdf.size() - 1);
+  G4ThreeVector p1 = SamplePoint(tiles[plane[k]]);
+
+  G4double cost = std::pow(G4UniformRand(), 1./(zenithExponent + 2));
+  G4double sint = std::sqrt((1 - cost)*(1 + cost));
+  G4double phi  = CLHEP::twopi*G4UniformRand();
+  G4ThreeVector dir(sint*std::cos(phi), sint*std::sin(phi), -cost);
+
+  G4int nCrossed = 0;
+  G4ThreeVector hit;
+  for (G4int id : plane) 
+    if (Crosses(tiles[id], p1, dir, hit)) ++nCrossed;
+  G4double weight = intensity/(CLHEP::m2*CLHEP::sr)*planeArea*CLHEP::twopi*CLHEP::sr
+    /((zenithExponent + 2)*std::max(nCrossed, 1));
+
+  G4ThreeVector start = p1 + ((startHeight - p1.z())/dir.z())*dir;
+
+  G4ParticleDefinition* muon = (G4UniformRand() < muPlusFraction) 
+    ? G4MuonPlus::Definition() : G4MuonMinus::Definition();
+  G4PrimaryParticle* particle = new G4PrimaryParticle(muon);
+  particle->SetKineticEnergy(SampleEnergy());
+  particle->SetMomentumDirection(dir);
+
+  G4PrimaryVertex* vertex = new G4PrimaryVertex(start, 0.);
+  vertex->SetPrimary(particle);
+  vertex->SetWeight(weight);
+  event->AddPrimaryVertex(vertex);
+}
+
+
+void PrimaryGeneratorAction::GenerateFromLibrary(G4Event* event) {
+
+  if (!library || openedLibrary != libraryFile) {
+    G4int nThreads = std::max(1, G4Threading::GetNumberOfRunningWorkerThreads());
+    library = PrimaryLibrary::Open(libraryFile, nThreads);
+    openedLibrary = libraryFile;
+    slice = std::max(0, G4Threading::G4GetThreadId()) % library->GetNumberOfSlices();
+    library->GetSlice(slice, sliceBegin, sliceEnd);
+    cursor = sliceBegin;
+  }
+
+  if (cursor >= sliceEnd) {
+    G4Exception("PrimaryGeneratorAction::GenerateFromLibrary", "Library010", JustWarning,
+                "Primary library slice exhausted, starting it over");
+    cursor = sliceBegin;
+  }
+
+  PrimaryLibrary::Entry entry;
+  library->Get(slice, cursor++, entry);
+
+  G4ParticleDefinition* definition = G4ParticleTable::GetParticleTable()->FindParticle(entry.pdg);
+  if (!definition) {
+    G4Exception("PrimaryGeneratorAction::GenerateFromLibrary", "Library011", EventMustBeAborted,
+                "Unknown PDG code in primary library");
+    return;
+  }
+  G4PrimaryParticle* particle = new G4PrimaryParticle(definition);
+  particle->SetKineticEnergy(entry.energy);
+  particle->SetMomentumDirection(entry.direction);
+
+  G4PrimaryVertex* vertex = new G4PrimaryVertex(entry.position, 0.);
+  vertex->SetPrimary(particle);
+  vertex->SetWeight(entry.weight);
+  event->AddPrimaryVertex(vertex);
+}
+
+
+void PrimaryGeneratorAction::GenerateFromShowers(G4Event* event) {
+
+  if (!showers || openedShowers != showerFile) {
+    showers = ShowerReader::Open(showerFile);
+    openedShowers = showerFile;
+    std::weak_ptr<ShowerReader> reader(showers);
+    MetricsExporter::SetGauge("cosmic_shower_queue_depth", [reader]() {
+      std::shared_ptr<ShowerReader> input = reader.lock();
+      return input ? (G4double)input->GetQueueDepth() : -1.;
+    });
+  }
+
+  ShowerReader::Shower shower;
+  if (!showers->Next(shower)) {
+    G4Exception("PrimaryGeneratorAction::GenerateFromShowers", "Shower001", RunMustBeAborted,
+                "Air-shower input exhausted");
+    return;
+  }
+
+  // Core uniformly on the footprint of the built planes
+  G4ThreeVector lo = detector->GetDetectorMin(), hi = detector->GetDetectorMax();
+  G4double cx = lo.x() + G4UniformRand()*(hi.x() - lo.x());
+  G4double cy = lo.y() + G4UniformRand()*(hi.y() - lo.y());
+  G4double area = (hi.x() - lo.x())*(hi.y() - lo.y());
+  G4double z0 = hi.z() + 1.*CLHEP::cm;
+
+  G4ParticleTable* table = G4ParticleTable::GetParticleTable();
+  for (const ShowerReader::Particle& p : shower.particles) {
+    G4ThreeVector pos(p.position.x() + cx, p.position.y() + cy, p.position.z() + z0);
+    if (pos.x() < lo.x() - showerMargin || pos.x() > hi.x() + showerMargin ||
+        pos.y() < lo.y() - showerMargin || pos.y() > hi.y() + showerMargin) continue;
+    G4ParticleDefinition* definition = table->FindParticle(p.pdg);
+    if (!definition) continue;
+
+    G4PrimaryParticle* particle = new G4PrimaryParticle(definition, p.momentum.x(), 
+                                                        p.momentum.y(), p.momentum.z());
+    G4PrimaryVertex* vertex = new G4PrimaryVertex(pos, p.time);
+    vertex->SetPrimary(particle);
+    vertex->SetWeight(area/CLHEP::m2);
+    event->AddPrimaryVertex(vertex);
+  }
+}
+
+
+G4double PrimaryGeneratorAction::Area(const TileInfo& tile) const {
+  return 2*tile.dz*(tile.bl1 + tile.bl2);
+}
+
+
+G4ThreeVector PrimaryGeneratorAction::SamplePoint(const TileInfo& tile) const {
+
+  // Fraction u along the tile with density proportional to the local width
+  G4double a = 0.5*(tile.bl2 - tile.bl1);
+  G4double r = G4UniformRand()*0.5*(tile.bl1 + tile.bl2);
+  G4double u = (std::fabs(a) > 1e-12*tile.bl1) 
+    ? (-tile.bl1 + std::sqrt(tile.bl1*tile.bl1 + 4*a*r))/(2*a) : r/tile.bl1;
+  G4double b = tile.bl1 + (tile.bl2 - tile.bl1)*u;
+  G4ThreeVector local((2*G4UniformRand() - 1)*b, 0, (2*u - 1)*tile.dz);
+  return tile.toGlobal.TransformPoint(local);
+}
+
+
+G4bool PrimaryGeneratorAction::Crosses(const TileInfo& tile, const G4ThreeVector& pos,
+                                       const G4ThreeVector& dir, G4ThreeVector& hit) const {
+
+  G4ThreeVector lpos = detector->ToLocalPoint(tile.id, pos);
+  G4ThreeVector ldir = detector->ToLocalAxis(tile.id, dir);
+  if (ldir.y() == 0) return false;
+  G4ThreeVector p = lpos - (lpos.y()/ldir.y())*ldir;
+  if (std::fabs(p.z()) > tile.dz) return false;
+  G4double b = tile.bl1 + (tile.bl2 - tile.bl1)*(p.z() + tile.dz)/(2*tile.dz);
+  if (std::fabs(p.x()) > b) return false;
+  hit = tile.toGlobal.TransformPoint(p);
+  return true;
+}
+
+
+G4double PrimaryGeneratorAction::SampleEnergy() const {
+
+  // Power law E^-gamma between eMin and eMax by inversion
+  G4double g = 1 - spectralIndex;
+  G4double r = G4UniformRand();
+  if (std::fabs(g) < 1e-9) return eMin*std::pow(eMax/eMin, r);
+  G4double a = std::pow(eMin, g), b = std::pow(eMax, g);
+  return std::pow(a + r*(b - a), 1/g);
+}
@@ -0,0 +1,93 @@
+#ifndef PrimaryGeneratorAction_h
+#define PrimaryGeneratorAction_h 1
+
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class DetectorConstruction;
+struct TileInfo;
+class G4Event;
+class G4GenericMessenger;
+class PrimaryLibrary;
+class ShowerReader;
+
+// Cosmic muons restricted to the detector acceptance. A (top, bottom) tile
+// pair is chosen from a precomputed table, a point is drawn uniformly on
+// the mid-plane of each tile and the muon is shot along the line joining
+// them. The vertex weight is the rate this line stands for, in Hz:
+//   w = I0 cos^n(theta) / sum_kl p_kl(line)
+// where the sum runs over every pair whose mid-planes the line crosses, so
+// lines reachable through several pairs are not double counted.
+// With only one plane built, a tile is chosen by area instead and the
+// direction follows the flux through the plane.
+//
+// With /cosmic/gun/library set, primaries are instead read from a
+// pre-generated PrimaryLibrary; each worker consumes its own slice.
+// With /cosmic/gun/showerFile set, each event is one external air shower
+// whose core is dropped uniformly on the tile footprint; the vertex weight
+// is then the footprint area in m2.
+class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction {
+
+public:
+
+  PrimaryGeneratorAction(const DetectorConstruction* det);
+  virtual ~PrimaryGeneratorAction();
+
+  virtual void GeneratePrimaries(G4Event*);
+
+  // "<file> <n>": write n primaries of the tile-pair generator as a
+  // PrimaryLibrary, e.g. to reuse one weighted sample across runs. Only the
+  // first worker writes; workers pick the command up at the next beamOn.
+  void WriteLibrary(const G4String& args);
+
+private:
+
+  void          Generate(G4Event*);
+  void          Replay(G4Event*);
+  void          GenerateFromLibrary(G4Event*);
+  void          GenerateFromShowers(G4Event*);
+  void          GenerateSinglePlane(G4Event*);
+  void          BuildPairTable();
+  G4ThreeVector SamplePoint(const TileInfo& tile) const;
+  G4bool        Crosses(const TileInfo& tile, const G4ThreeVector& pos,
+                        const G4ThreeVector& dir, G4ThreeVector& hit) const;
+  G4double      SampleEnergy() const;
+  G4double      Area(const TileInfo& tile) const;
+
+  const DetectorConstruction* detector;
+
+  G4int                 tableVersion;   // of the detector's tile table
+  std::vector<G4int>    topTiles, bottomTiles;
+  std::vector<G4double> pairCdf;
+  std::vector<G4double> pairProb;
+  G4double              startHeight;
+  G4double              planeArea;
+
+  G4double zenithExponent;
+  G4double spectralIndex;
+  G4double eMin, eMax;
+  G4double intensity;
+  G4double muPlusFraction;
+
+  G4String                        libraryFile;
+  G4String                        openedLibrary;
+  std::shared_ptr<PrimaryLibrary> library;
+  G4int                           slice;
+  uint64_t                        sliceBegin, sliceEnd, cursor;
+
+  G4String                      showerFile;
+  G4String                      openedShowers;
+  G4double                      showerMargin;
+  std::shared_ptr<ShowerReader> showers;
+
+  G4String replayFile;
+
+  G4GenericMessenger* messenger;
+};
+
+#endif
@@ -0,0 +1,189 @@
+#include "PrimaryLibrary.hh"
+
+#include "G4AutoLock.hh"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+  const char kMagic[8] = { 'C', 'R', 'P', 'L', 'I', 'B', 0, 1 };
+  const uint64_t kPage = 4096;
+
+  G4Mutex libraryMutex = G4MUTEX_INITIALIZER;
+  std::map<G4String, std::weak_ptr<PrimaryLibrary> > openLibraries;
+
+  uint64_t PageAlign(uint64_t n) { return (n + kPage - 1)/kPage*kPage; }
+}
+
+
+std::shared_ptr<PrimaryLibrary> PrimaryLibrary::Open(const G4String& file, G4int nSlices) {
+
+  G4AutoLock lock(&libraryMutex);
+  std::shared_ptr<PrimaryLibrary> library = openLibraries[file].lock();
+  if (!library) {
+    library.reset(new PrimaryLibrary(file, nSlices));
+    openLibraries[file] = library;
+  }
+  return library;
+}
+
+
+PrimaryLibrary::PrimaryLibrary(const G4String& file, G4int nSlices)
+  : fileName(file), base(0), length(0), header(0), count(0),
+    cursors(nSlices > 0 ? nSlices : 1), window(1 << 16), stopping(false) {
+
+  int fd = open(file.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(Header)) {
+    if (fd >= 0) close(fd);
+    G4Exception("PrimaryLibrary::PrimaryLibrary", "Library001", FatalException,
+                ("Cannot open primary library " + file).c_str());
+    return;
+  }
+  length = st.st_size;
+  void* map = mmap(0, length, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    G4Exception("PrimaryLibrary::PrimaryLibrary", "Library002", FatalException,
+                ("Cannot map primary library " + file).c_str());
+    return;
+  }
+  base   = static_cast<const char*>(map);
+  header = reinterpret_cast<const Header*>(base);
+  count  = header->count;
+
+  G4bool valid = (std::memcmp(header->magic, kMagic, sizeof(kMagic)) == 0);
+  for (G4int c=0; valid && c<kNumColumns; ++c) 
+    valid = (header->offset[c] + count*4 <= length);
+  if (!valid) {
+    G4Exception("PrimaryLibrary::PrimaryLibrary", "Library003", FatalException,
+                ("Not a primary library or truncated: " + file).c_str());
+    return;
+  }
+
+  for (G4int s=0; s<(G4int)cursors.size(); ++s) {
+    uint64_t begin, end;
+    GetSlice(s, begin, end);
+    cursors[s].store(begin, std::memory_order_relaxed);
+  }
+  madvise(const_cast<char*>(base), length, MADV_SEQUENTIAL);
+  prefetcher = std::thread(&PrimaryLibrary::Prefetch, this);
+
+  G4cout << "PrimaryLibrary: " << count << " primaries from " << file 
+         << " in " << cursors.size() << " slices" << G4endl;
+}
+
+
+PrimaryLibrary::~PrimaryLibrary() {
+
+  if (prefetcher.joinable()) {
+    {
+      std::lock_guard<std::mutex> guard(stopMutex);
+      stopping = true;
+    }
+    stopCondition.notify_all();
+    prefetcher.join();
+  }
+  if (base) munmap(const_cast<char*>(base), length);
+}
+
+
+void PrimaryLibrary::GetSlice(G4int slice, uint64_t& begin, uint64_t& end) const {
+
+  uint64_t n = cursors.size();
+  begin = count*slice/n;
+  end   = count*(slice + 1)/n;
+}
+
+
+void PrimaryLibrary::Get(G4int slice, uint64_t i, Entry& entry) {
+
+  const float* x = ColumnData<float>(kX);
+  const float* y = ColumnData<float>(kY);
+  const float* z = ColumnData<float>(kZ);
+  const float* dx = ColumnData<float>(kDX);
+  const float* dy = ColumnData<float>(kDY);
+  const float* dz = ColumnData<float>(kDZ);
+  entry.position.set(x[i], y[i], z[i]);
+  entry.direction.set(dx[i], dy[i], dz[i]);
+  entry.energy = ColumnData<float>(kEnergy)[i];
+  entry.weight = ColumnData<float>(kWeight)[i];
+  entry.pdg    = ColumnData<int32_t>(kPdg)[i];
+  cursors[slice].store(i, std::memory_order_relaxed);
+}
+
+
+void PrimaryLibrary::Prefetch() {
+
+  std::vector<uint64_t> advised(cursors.size(), 0);
+  std::unique_lock<std::mutex> lock(stopMutex);
+  while (!stopping) {
+    for (size_t s=0; s<cursors.size(); ++s) {
+      uint64_t begin, end;
+      GetSlice(s, begin, end);
+      uint64_t cursor = cursors[s].load(std::memory_order_relaxed);
+      if (cursor + window < advised[s]) advised[s] = cursor;
+      uint64_t from   = std::max(cursor, advised[s]);
+      uint64_t to     = std::min(cursor + window, end);
+      if (from >= to) continue;
+      for (G4int c=0; c<kNumColumns; ++c) {
+        uint64_t lo = (header->offset[c] + from*4)/kPage*kPage;
+        uint64_t hi = PageAlign(header->offset[c] + to*4);
+        madvise(const_cast<char*>(base) + lo, std::min<uint64_t>(hi, length) - lo, MADV_WILLNEED);
+      }
+      advised[s] = to;
+    }
+    stopCondition.wait_for(lock, std::chrono::milliseconds(20));
+  }
+}
+
+
+void PrimaryLibrary::Write(const G4String& file, const std::vector<Entry>& entries) {
+
+  Header head;
+  std::memset(&head, 0, sizeof(head));
+  std::memcpy(head.magic, kMagic, sizeof(kMagic));
+  head.count = entries.size();
+  uint64_t offset = PageAlign(sizeof(Header));
+  for (G4int c=0; c<kNumColumns; ++c) {
+    head.offset[c] = offset;
+    offset = PageAlign(offset + 4*head.count);
+  }
+
+  std::ofstream out(file.c_str(), std::ios::binary | std::ios::trunc);
+  if (!out) {
+    G4Exception("PrimaryLibrary::Write", "Library004", FatalException,
+                ("Cannot write primary library " + file).c_str());
+    return;
+  }
+  out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+
+  std::vector<char> column(4*head.count);
+  for (G4int c=0; c<kNumColumns; ++c) {
+    for (size_t i=0; i<entries.size(); ++i) {
+      const Entry& e = entries[i];
+      float v = 0;
+      switch (c) {
+        case kX:      v = e.position.x();  break;
+        case kY:      v = e.position.y();  break;
+        case kZ:      v = e.position.z();  break;
+        case kDX:     v = e.direction.x(); break;
+        case kDY:     v = e.direction.y(); break;
+        case kDZ:     v = e.direction.z(); break;
+        case kEnergy: v = e.energy;        break;
+        case kWeight: v = e.weight;        break;
+        case kPdg:    { int32_t pdg = e.pdg; std::memcpy(&column[4*i], &pdg, 4); continue; }
+      }
+      std::memcpy(&column[4*i], &v, 4);
+    }
+    out.seekp(head.offset[c]);
+    out.write(column.data(), column.size());
+  }
+}
@@ -0,0 +1,82 @@
+#ifndef PrimaryLibrary_h
+#define PrimaryLibrary_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pre-generated primaries in a structure-of-arrays binary file, read through
+// mmap. Layout: a header with the entry count and the byte offset of each
+// column, then one page-aligned column per quantity. Positions are in mm,
+// energies in MeV, pdg is int32 and everything else float32.
+//
+// One mapping is shared by all threads. Each worker owns a disjoint slice
+// of the entries and only publishes its cursor, so reading takes no lock;
+// a background thread keeps the pages just ahead of every cursor resident.
+class PrimaryLibrary {
+
+public:
+
+  enum Column { kX, kY, kZ, kDX, kDY, kDZ, kEnergy, kWeight, kPdg, kNumColumns };
+
+  struct Header {
+    char     magic[8];
+    uint64_t count;
+    uint64_t offset[kNumColumns];
+  };
+
+  struct Entry {
+    G4ThreeVector position;
+    G4ThreeVector direction;
+    G4double      energy;
+    G4double      weight;
+    G4int         pdg;
+  };
+
+  // Shared, reference counted mapping of a library file, split into nSlices
+  static std::shared_ptr<PrimaryLibrary> Open(const G4String& file, G4int nSlices);
+
+  // Write entries in library format
+  static void Write(const G4String& file, const std::vector<Entry>& entries);
+
+  ~PrimaryLibrary();
+
+  uint64_t GetCount() const { return count; }
+  G4int    GetNumberOfSlices() const { return (G4int)cursors.size(); }
+  void     GetSlice(G4int slice, uint64_t& begin, uint64_t& end) const;
+
+  // Read entry i and mark it as the current position of a slice
+  void Get(G4int slice, uint64_t i, Entry& entry);
+
+private:
+
+  PrimaryLibrary(const G4String& file, G4int nSlices);
+  void Prefetch();
+
+  template <class T> const T* ColumnData(Column c) const {
+    return reinterpret_cast<const T*>(base + header->offset[c]);
+  }
+
+  G4String      fileName;
+  const char*   base;
+  size_t        length;
+  const Header* header;
+  uint64_t      count;
+
+  std::vector<std::atomic<uint64_t> > cursors;
+  uint64_t                            window;
+
+  std::thread             prefetcher;
+  std::mutex              stopMutex;
+  std::condition_variable stopCondition;
+  G4bool                  stopping;
+};
+
+#endif
@@ -0,0 +1,317 @@
+#include "RunAction.hh"
+#include "DetectorConstruction.hh"
+#include "HitWriter.hh"
+#include "MetricsExporter.hh"
+#include "PerfCounters.hh"
+#include "SparseCodec.hh"
+#include "SteppingProfiler.hh"
+#include "TrackFitter.hh"
+
+#include "G4Run.hh"
+#include "G4AccumulableManager.hh"
+#include "G4GenericMessenger.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+RunAction::RunAction(const DetectorConstruction* det) 
+  : G4UserRunAction(), detector(det), nTriggered("nTriggered", 0), nAborted("nAborted", 0),
+    sumWeight("sumWeight", 0.), sumWeightTriggered("sumWeightTriggered", 0.),
+    nStacked("nStacked", 0), nKilled("nKilled", 0), nWaiting("nWaiting", 0),
+    timeSaved("timeSaved", 0.), hTileEdep(-1), hPmtEdep(-1), hPairTime(-1),
+    hEventTime(-1),
+    blockEvents(65536), hitBlock(0), fitThreads(2), fitBatch(0),
+    metricsInterval(30.) {
+
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(nTriggered);
+  accumulableManager->RegisterAccumulable(nAborted);
+  accumulableManager->RegisterAccumulable(sumWeight);
+  accumulableManager->RegisterAccumulable(sumWeightTriggered);
+  accumulableManager->RegisterAccumulable(nStacked);
+  accumulableManager->RegisterAccumulable(nKilled);
+  accumulableManager->RegisterAccumulable(nWaiting);
+  accumulableManager->RegisterAccumulable(timeSaved);
+
+  messenger = new G4GenericMessenger(this, "/cosmic/output/", "Event output");
+  messenger->DeclareProperty("file", outputFile, 
+                             "Base name of the columnar hit file, empty for no output");
+  messenger->DeclareProperty("blockEvents", blockEvents, "Events per compressed block");
+  messenger->DeclareProperty("fitThreads", fitThreads,
+                             "Threads fitting coincidence tracks into <file>_run<id>.tracks, 0 for none");
+  messenger->DeclareMethod("benchmarkMerge", &RunAction::BenchmarkMerge, 
+                           "Time the histogram merge for up to the given number of threads");
+
+  perfMessenger = new G4GenericMessenger(this, "/cosmic/perf/", "Hardware performance counters");
+  perfMessenger->DeclareMethod("enable", &RunAction::SetPerfCounters,
+                               "Count cycles, instructions, cache and branch misses per event"
+                               " and during construction");
+
+  metricsMessenger = new G4GenericMessenger(this, "/cosmic/metrics/", "Metrics file for monitoring");
+  metricsMessenger->DeclareProperty("file", metricsFile,
+                                    "Prometheus text file, rewritten atomically, empty for none");
+  metricsMessenger->DeclareProperty("interval", metricsInterval, "Seconds between updates");
+}
+
+
+RunAction::~RunAction() {
+  delete messenger;
+  delete perfMessenger;
+  delete metricsMessenger;
+}
+
+
+void RunAction::BeginOfRunAction(const G4Run* run) {
+
+  G4AccumulableManager::Instance()->Reset();
+  timer.Start();
+
+  // Booked every run, the tile and PMT counts follow the geometry
+  G4int nTiles = detector->GetNumberOfTiles();
+  histograms = HistogramSet();
+  hTileEdep = histograms.Book("tileEdep", nTiles, 100, 0., 20.);
+  hPmtEdep  = histograms.Book("pmtEdep", detector->GetNumberOfPmts(), 100, 0., 50.);
+  hEventTime = histograms.Book("eventTime", 1, 60, -2., 4.);
+  coincidences.Book(histograms, detector);
+
+  // Pair times use the top x bottom cells of the coincidence matrix, which
+  // is empty for layouts without a tile-pair table. They are residuals to
+  // the centre-to-centre time of flight, so one window fits every pair.
+  G4int nPairs = coincidences.GetNumberOfRows()*coincidences.GetNumberOfColumns();
+  hPairTime = histograms.Book("pairTime", nPairs, 40, -10., 10.);
+  if (!IsMaster()) histograms.Register();
+
+  if (!outputFile.empty()) {
+    std::ostringstream name;
+    name << outputFile << "_run" << run->GetRunID() << ".hits";
+    // One mask per built plane, so a file of a single plane counts any hit
+    // as a coincidence, like the trigger
+    G4int nWords = SparseCodec::Words(nTiles);
+    G4int slot[kNumPlanes], nPlanes = 0;
+    for (G4int p=0; p<kNumPlanes; ++p) slot[p] = detector->HasPlane(p) ? nPlanes++ : -1;
+    std::vector<uint64_t> planeMasks(nPlanes*nWords, 0);
+    for (const TileInfo& tile : detector->GetTiles())
+      planeMasks[slot[tile.plane]*nWords + tile.id/64] |= (uint64_t)1 << (tile.id % 64);
+    hitWriter = HitWriter::Open(name.str(), nTiles, planeMasks);
+
+    // A track needs both planes
+    std::ostringstream fitName;
+    fitName << outputFile << "_run" << run->GetRunID() << ".tracks";
+    if (fitThreads > 0 && nPlanes < kNumPlanes) {
+      if (IsMaster()) G4cout << "RunAction: single plane built, track fits skipped" << G4endl;
+    } else if (fitThreads > 0) {
+      trackFitter = TrackFitter::Open(fitName.str(), detector, fitThreads);
+    }
+  }
+
+  // The master holds every shared writer, so it owns the gauges
+  if (IsMaster() && !metricsFile.empty()) {
+    std::weak_ptr<HitWriter> hits(hitWriter);
+    MetricsExporter::SetGauge("cosmic_hit_writer_queue_depth", [hits]() {
+      std::shared_ptr<HitWriter> writer = hits.lock();
+      return writer ? (G4double)writer->GetQueueDepth() : -1.;
+    });
+    std::weak_ptr<TrackFitter> fits(trackFitter);
+    MetricsExporter::SetGauge("cosmic_track_fitter_queue_depth", [fits]() {
+      std::shared_ptr<TrackFitter> fitter = fits.lock();
+      return fitter ? (G4double)fitter->GetQueueDepth() : -1.;
+    });
+    metricsExporter = MetricsExporter::Open(metricsFile, metricsInterval);
+  }
+}
+
+
+void RunAction::EndOfRunAction(const G4Run* run) {
+
+  if (hitWriter) {
+    if (hitBlock) hitWriter->Submit(hitBlock);
+    hitBlock = 0;
+    hitWriter.reset();
+  }
+  if (trackFitter) {
+    if (fitBatch) trackFitter->Submit(fitBatch);
+    fitBatch = 0;
+    trackFitter.reset();
+  }
+  metricsExporter.reset();
+
+  G4int nofEvents = run->GetNumberOfEvent();
+  if (nofEvents == 0) return;
+
+  // Rough estimate, not a measurement: killed tracks are assumed to cost as
+  // much as the average tracked one, and secondaries they would have made
+  // are ignored. Measure by timing the same seed with /cosmic/stack/enable
+  // false. The master has no local tracks, so only event loops contribute.
+  timer.Stop();
+  G4int nTracked = nStacked.GetValue() - nKilled.GetValue();
+  if (nTracked > 0) 
+    timeSaved += nKilled.GetValue()*timer.GetRealElapsed()/nTracked;
+
+  G4AccumulableManager::Instance()->Merge();
+  if (!IsMaster()) return;
+
+  // Worker histograms are summed pairwise, one thread per pair of a level
+  std::vector<HistogramSet*> workerSets = HistogramSet::GetRegistered();
+  G4Timer mergeTimer;
+  mergeTimer.Start();
+  histograms.Merge(workerSets, (G4int)workerSets.size());
+  mergeTimer.Stop();
+  if (!outputFile.empty()) {
+    std::ostringstream name;
+    name << outputFile << "_run" << run->GetRunID();
+    histograms.Write(name.str() + ".hist");
+    coincidences.Write(histograms, nofEvents, name.str() + ".coinc");
+  }
+
+  G4cout << G4endl
+         << "--------------------End of Run------------------------------" << G4endl
+         << " Events processed      : " << nofEvents << G4endl
+         << " Top/bottom coincidence: " << nTriggered.GetValue() 
+         << " (" << 100.*nTriggered.GetValue()/nofEvents << " %)" << G4endl
+         << " Aborted early         : " << nAborted.GetValue()
+         << " (" << 100.*nAborted.GetValue()/nofEvents << " %)" << G4endl
+         << " Weighted rate (all)   : " << sumWeight.GetValue()/nofEvents << G4endl
+         << " Weighted rate (coinc.): " << sumWeightTriggered.GetValue()/nofEvents << G4endl;
+  if (nStacked.GetValue() > 0) {
+    G4cout << " Secondaries classified: " << nStacked.GetValue() << G4endl
+           << "   killed              : " << nKilled.GetValue()
+           << " (" << 100.*nKilled.GetValue()/nStacked.GetValue() << " %)" << G4endl
+           << "   postponed           : " << nWaiting.GetValue()
+           << " (" << 100.*nWaiting.GetValue()/nStacked.GetValue() << " %)" << G4endl
+           << "   time saved (rough)  : " << timeSaved.GetValue() 
+           << " s summed over threads, killed x mean cost per tracked track;" << G4endl
+           << "                         time a same-seed run with /cosmic/stack/enable false to measure" 
+           << G4endl;
+  }
+  G4cout << " Histograms merged     : " << workerSets.size() << " threads in "
+         << mergeTimer.GetRealElapsed()*1000. << " ms" << G4endl
+         << "------------------------------------------------------------" << G4endl;
+
+  std::ostringstream profileName;
+  if (!outputFile.empty()) profileName << outputFile << "_run" << run->GetRunID() << ".prof";
+  SteppingProfiler::Report(20, profileName.str());
+  PerfCounters::Report();
+}
+
+
+void RunAction::CountEvent(G4bool triggered, G4bool aborted, G4double weight) {
+
+  sumWeight += weight;
+  if (triggered) {
+    nTriggered += 1;
+    sumWeightTriggered += weight;
+  }
+  if (aborted) nAborted += 1;
+}
+
+
+void RunAction::CountStackedTrack(G4ClassificationOfNewTrack classification) {
+
+  nStacked += 1;
+  if (classification == fKill)    nKilled += 1;
+  if (classification == fWaiting) nWaiting += 1;
+}
+
+
+void RunAction::FillHistograms(const std::vector<G4double>& tileEdep, 
+                               const std::vector<G4double>& tileTime,
+                               const std::vector<G4double>& pmtEdep, G4double threshold,
+                               G4double weight) {
+
+  const std::vector<TileInfo>& tiles = detector->GetTiles();
+  for (G4int p=0; p<kNumPlanes; ++p) hitTiles[p].clear();
+  for (size_t k=0; k<tileEdep.size(); ++k) {
+    if (tileEdep[k] <= 0) continue;
+    histograms.Fill(hTileEdep, k, tileEdep[k]/CLHEP::MeV, weight);
+    hitTiles[tiles[k].plane].push_back(k);
+  }
+  for (size_t k=0; k<pmtEdep.size(); ++k) 
+    if (pmtEdep[k] > 0) histograms.Fill(hPmtEdep, k, pmtEdep[k]/CLHEP::MeV, weight);
+
+  // Pairs within one station, summed over the stations. Layouts too large
+  // for a tile-pair table have no pair histograms.
+  if (!detector->HasPairTable()) return;
+  for (G4int top : hitTiles[kTopPlane])
+    for (G4int bottom : hitTiles[kBottomPlane]) {
+      if (tiles[top].station != tiles[bottom].station) continue;
+      G4double tof = detector->GetTilePair(top, bottom).timeOfFlight;
+      histograms.Fill(hPairTime, coincidences.GetCell(top, bottom), 
+                      (tileTime[bottom] - tileTime[top] - tof)/CLHEP::ns, weight);
+    }
+
+  coincidences.Fill(histograms, tileEdep, threshold, weight);
+}
+
+
+void RunAction::FitTrack(G4int eventId, const std::vector<G4double>& tileEdep,
+                         G4double threshold, G4double weight) {
+
+  if (!trackFitter) return;
+  if (!fitBatch) fitBatch = trackFitter->Acquire();
+
+  fitBatch->Add(eventId, weight, tileEdep, threshold);
+  if (fitBatch->Events() >= 256) {
+    trackFitter->Submit(fitBatch);
+    fitBatch = 0;
+  }
+}
+
+
+void RunAction::FillEventTime(G4double time) {
+  histograms.Fill(hEventTime, 0, std::log10(std::max(time, 1e-9*CLHEP::s)/CLHEP::ms));
+}
+
+
+void RunAction::SetPerfCounters(G4bool val) {
+  PerfCounters::SetEnabled(val);
+}
+
+
+void RunAction::BenchmarkMerge(G4int maxThreads) {
+
+  if (!histograms.IsBooked()) {
+    G4cout << "RunAction: histograms are booked at the first run" << G4endl;
+    return;
+  }
+  histograms.BenchmarkMerge(maxThreads);
+}
+
+
+void RunAction::RecordHits(G4int eventId, const std::vector<G4double>& edep,
+                           const std::vector<G4double>& time, G4double weight) {
+
+  if (!hitWriter) return;
+  if (!hitBlock) hitBlock = hitWriter->Acquire();
+
+  G4int nTiles = edep.size();
+  denseEdep.resize(nTiles);
+  denseTime.resize(nTiles);
+  for (G4int k=0; k<nTiles; ++k) {
+    denseEdep[k] = edep[k]/CLHEP::MeV;
+    denseTime[k] = time[k]/CLHEP::ns;
+  }
+
+  // Encode straight into the block, then trim the packed columns to the hits
+  size_t words = hitBlock->mask.size(), hits = hitBlock->Hits();
+  hitBlock->mask.resize(words + SparseCodec::Words(nTiles));
+  hitBlock->edep.resize(hits + nTiles);
+  hitBlock->time.resize(hits + nTiles);
+  G4int n = SparseCodec::Encode(denseEdep.data(), denseTime.data(), nTiles, &hitBlock->mask[words],
+                                &hitBlock->edep[hits], &hitBlock->time[hits]);
+  hitBlock->edep.resize(hits + n);
+  hitBlock->time.resize(hits + n);
+  if (n == 0) {
+    hitBlock->mask.resize(words);
+    return;
+  }
+  hitBlock->event.push_back(eventId);
+  hitBlock->weight.push_back(weight);
+
+  if ((G4int)hitBlock->Events() >= blockEvents) {
+    hitWriter->Submit(hitBlock);
+    hitBlock = 0;
+  }
+}
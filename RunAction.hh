@@ -0,0 +1,100 @@
+#ifndef RunAction_h
+#define RunAction_h 1
+
+#include "G4UserRunAction.hh"
+#include "G4Accumulable.hh"
+#include "G4ClassificationOfNewTrack.hh"
+#include "G4Timer.hh"
+#include "globals.hh"
+
+#include "CoincidenceMatrix.hh"
+#include "HistogramSet.hh"
+#include "TileInfo.hh"
+
+#include <memory>
+#include <vector>
+
+class G4Run;
+class G4GenericMessenger;
+class DetectorConstruction;
+class HitWriter;
+struct HitBlock;
+class TrackFitter;
+class MetricsExporter;
+struct FitBatch;
+
+class RunAction : public G4UserRunAction {
+
+public:
+
+  RunAction(const DetectorConstruction* det);
+  virtual ~RunAction();
+
+  virtual void BeginOfRunAction(const G4Run*);
+  virtual void EndOfRunAction(const G4Run*);
+
+  void CountEvent(G4bool triggered, G4bool aborted, G4double weight);
+  void CountStackedTrack(G4ClassificationOfNewTrack classification);
+
+  // Per tile and per PMT energy spectra, hit time differences per
+  // top/bottom tile pair and the pair coincidence matrix of tiles above
+  // threshold. Pairs are taken within a station and summed over stations.
+  void FillHistograms(const std::vector<G4double>& tileEdep, const std::vector<G4double>& tileTime,
+                      const std::vector<G4double>& pmtEdep, G4double threshold, G4double weight);
+
+  // Wall time per event, log10 of milliseconds
+  void FillEventTime(G4double time);
+
+  void BenchmarkMerge(G4int maxThreads);
+  void SetPerfCounters(G4bool val);
+
+  // Append the hit tiles of one event to the sparse columnar output, if enabled
+  void RecordHits(G4int eventId, const std::vector<G4double>& edep,
+                  const std::vector<G4double>& time, G4double weight);
+
+  // Queue a coincidence event for the straight-line fit, if output is enabled
+  void FitTrack(G4int eventId, const std::vector<G4double>& tileEdep, G4double threshold,
+                G4double weight);
+
+private:
+
+  const DetectorConstruction* detector;
+
+  G4Accumulable<G4int> nTriggered;
+  G4Accumulable<G4int> nAborted;
+  G4Accumulable<G4double> sumWeight;
+  G4Accumulable<G4double> sumWeightTriggered;
+
+  G4Accumulable<G4int>    nStacked;
+  G4Accumulable<G4int>    nKilled;
+  G4Accumulable<G4int>    nWaiting;
+  G4Accumulable<G4double> timeSaved;
+  G4Timer                 timer;
+
+  HistogramSet       histograms;
+  G4int              hTileEdep;
+  G4int              hPmtEdep;
+  G4int              hPairTime;
+  G4int              hEventTime;
+  std::vector<G4int> hitTiles[kNumPlanes];
+  CoincidenceMatrix  coincidences;
+
+  G4String                   outputFile;
+  G4int                      blockEvents;
+  std::shared_ptr<HitWriter> hitWriter;
+  HitBlock*                  hitBlock;
+  std::vector<float>         denseEdep;
+  std::vector<float>         denseTime;
+  G4int                        fitThreads;
+  std::shared_ptr<TrackFitter> trackFitter;
+  FitBatch*                    fitBatch;
+  G4GenericMessenger*        messenger;
+  G4GenericMessenger*        perfMessenger;
+
+  G4String                         metricsFile;
+  G4double                         metricsInterval;
+  std::shared_ptr<MetricsExporter> metricsExporter;
+  G4GenericMessenger*              metricsMessenger;
+};
+
+#endif
@@ -0,0 +1,155 @@
+#include "ShowerReader.hh"
+
+#include "G4AutoLock.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+namespace {
+  G4Mutex readerMutex = G4MUTEX_INITIALIZER;
+  std::map<G4String, std::weak_ptr<ShowerReader> > openReaders;
+
+  const size_t kRecordSize = 2*4 + 7*4;
+}
+
+
+std::shared_ptr<ShowerReader> ShowerReader::Open(const G4String& file, size_t capacity) {
+
+  G4AutoLock lock(&readerMutex);
+  std::shared_ptr<ShowerReader> reader = openReaders[file].lock();
+  if (!reader) {
+    reader.reset(new ShowerReader(file, capacity));
+    openReaders[file] = reader;
+  }
+  return reader;
+}
+
+
+ShowerReader::ShowerReader(const G4String& file, size_t capacity)
+  : fileName(file), queue(capacity), finished(false), stopping(false) {
+
+  binary = !(file.size() > 4 && file.compare(file.size() - 4, 4, ".csv") == 0);
+  parser = std::thread(&ShowerReader::Parse, this);
+}
+
+
+ShowerReader::~ShowerReader() {
+
+  stopping = true;
+  if (parser.joinable()) parser.join();
+}
+
+
+G4bool ShowerReader::Next(Shower& shower) {
+
+  for (;;) {
+    if (queue.TryPop(shower)) return true;
+    if (finished.load(std::memory_order_acquire)) return queue.TryPop(shower);
+    std::this_thread::yield();
+  }
+}
+
+
+void ShowerReader::Push(Shower& shower) {
+
+  while (!queue.TryPush(std::move(shower))) {
+    if (stopping) return;
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+
+void ShowerReader::Parse() {
+
+  std::ifstream in(fileName.c_str(), binary ? std::ios::binary : std::ios::in);
+  if (!in) {
+    G4cerr << "ShowerReader: cannot open " << fileName << G4endl;
+    finished.store(true, std::memory_order_release);
+    return;
+  }
+
+  Shower   current;
+  G4bool   open = false;
+  G4long   id;
+  Particle particle;
+  G4long   nShowers = 0;
+
+  while (!stopping) {
+    G4bool ok = binary ? ReadBinary(in, id, particle) : ReadCsv(in, id, particle);
+    if (!ok) break;
+    if (open && id != current.id) {
+      Push(current);
+      ++nShowers;
+      current = Shower();
+      open = false;
+    }
+    if (!open) {
+      current.id = id;
+      open = true;
+    }
+    current.particles.push_back(particle);
+  }
+  if (open && !stopping) {
+    Push(current);
+    ++nShowers;
+  }
+
+  finished.store(true, std::memory_order_release);
+  G4cout << "ShowerReader: " << nShowers << " showers read from " << fileName << G4endl;
+}
+
+
+G4bool ShowerReader::ReadCsv(std::istream& in, G4long& id, Particle& particle) {
+
+  std::string line;
+  while (std::getline(in, line)) {
+    const char* p = line.c_str();
+    while (*p == ' ' || *p == '\t') ++p;
+    if (*p == 0 || *p == '#' || std::isalpha((unsigned char)*p)) continue;
+
+    G4double v[9];
+    G4int n = 0;
+    char* end;
+    for (; n<9; ++n) {
+      v[n] = std::strtod(p, &end);
+      if (end == p) break;
+      p = end;
+      while (*p == ',' || *p == ' ' || *p == '\t' || *p == ';') ++p;
+    }
+    if (n < 9) {
+      G4cerr << "ShowerReader: skipping malformed line in " << fileName << G4endl;
+      continue;
+    }
+    id = (G4long)v[0];
+    particle.pdg = (G4int)v[1];
+    particle.position.set(v[2]*CLHEP::cm, v[3]*CLHEP::cm, v[4]*CLHEP::cm);
+    particle.momentum.set(v[5]*CLHEP::GeV, v[6]*CLHEP::GeV, v[7]*CLHEP::GeV);
+    particle.time = v[8]*CLHEP::ns;
+    return true;
+  }
+  return false;
+}
+
+
+G4bool ShowerReader::ReadBinary(std::istream& in, G4long& id, Particle& particle) {
+
+  char record[kRecordSize];
+  if (!in.read(record, kRecordSize)) return false;
+
+  int32_t ids[2];
+  float   v[7];
+  std::memcpy(ids, record, sizeof(ids));
+  std::memcpy(v, record + sizeof(ids), sizeof(v));
+  id = ids[0];
+  particle.pdg = ids[1];
+  particle.position.set(v[0]*CLHEP::cm, v[1]*CLHEP::cm, v[2]*CLHEP::cm);
+  particle.momentum.set(v[3]*CLHEP::GeV, v[4]*CLHEP::GeV, v[5]*CLHEP::GeV);
+  particle.time = v[6]*CLHEP::ns;
+  return true;
+}
@@ -0,0 +1,69 @@
+#ifndef ShowerReader_h
+#define ShowerReader_h 1
+
+#include "BoundedQueue.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Streams air-shower particle lists produced by external generators. A
+// dedicated thread parses the file and pushes one Shower per event into a
+// bounded lock-free queue that the workers pop from, so memory use is set
+// by the queue capacity and not by the file size.
+//
+// Accepted inputs, one particle per record, particles of one shower
+// consecutive, positions relative to the shower core:
+//  - CSV (".csv"): shower,pdg,x,y,z,px,py,pz,t in cm, GeV/c and ns; lines
+//    starting with '#' or a letter are skipped
+//  - binary (anything else): packed little-endian records of int32 shower,
+//    int32 pdg and float32 x,y,z,px,py,pz,t in the same units
+class ShowerReader {
+
+public:
+
+  struct Particle {
+    G4int         pdg;
+    G4ThreeVector position;
+    G4ThreeVector momentum;
+    G4double      time;
+  };
+
+  struct Shower {
+    G4long                id;
+    std::vector<Particle> particles;
+  };
+
+  // Shared reader of one file; the first caller starts the parsing thread
+  static std::shared_ptr<ShowerReader> Open(const G4String& file, size_t capacity = 256);
+
+  ~ShowerReader();
+
+  // Next complete shower, waiting for the parser if needed. Returns false
+  // once the input is exhausted.
+  G4bool Next(Shower& shower);
+
+  size_t GetQueueDepth() const { return queue.Size(); }
+
+private:
+
+  ShowerReader(const G4String& file, size_t capacity);
+
+  void   Parse();
+  G4bool ReadCsv(std::istream& in, G4long& id, Particle& particle);
+  G4bool ReadBinary(std::istream& in, G4long& id, Particle& particle);
+  void   Push(Shower& shower);
+
+  G4String             fileName;
+  G4bool               binary;
+  BoundedQueue<Shower> queue;
+  std::atomic<G4bool>  finished;
+  std::atomic<G4bool>  stopping;
+  std::thread          parser;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "SlowEventMonitor.hh"
+
+#include "G4Event.hh"
+#include "G4GenericMessenger.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+SlowEventMonitor::SlowEventMonitor() : threshold(0), prefix("slow") {
+
+  messenger = new G4GenericMessenger(this, "/cosmic/slow/", "Slow event capture");
+  messenger->DeclareMethodWithUnit("threshold", "ms", &SlowEventMonitor::SetThreshold,
+                                   "Save events taking longer than this, 0 for none");
+  messenger->DeclareProperty("prefix", prefix, "Path prefix of the slow event records");
+}
+
+
+SlowEventMonitor::~SlowEventMonitor() {
+  delete messenger;
+}
+
+
+void SlowEventMonitor::SetThreshold(G4double val) {
+
+  threshold = val;
+  if (threshold > 0) {
+    G4RunManager* runManager = G4RunManager::GetRunManager();
+    runManager->StoreRandomNumberStatusToG4Event(runManager->GetFlagRandomNumberStatusToG4Event() | 1);
+  }
+}
+
+
+void SlowEventMonitor::BeginEvent() {
+
+  steps.clear();
+  start = Clock::now();
+}
+
+
+G4double SlowEventMonitor::EndEvent(const G4Event* event) {
+
+  G4double time = std::chrono::duration<G4double>(Clock::now() - start).count()*CLHEP::s;
+  if (threshold > 0 && time > threshold) Save(event, time);
+  return time;
+}
+
+
+void SlowEventMonitor::Save(const G4Event* event, G4double time) const {
+
+  const G4Run* run = G4RunManager::GetRunManager()->GetCurrentRun();
+  G4int runId = run ? run->GetRunID() : 0;
+  std::ostringstream name;
+  name << prefix << "_run" << runId << "_evt" << event->GetEventID() << ".slow";
+
+  std::ofstream out(name.str().c_str());
+  out << "# run " << runId << " event " << event->GetEventID() << " took "
+      << time/CLHEP::ms << " ms\n";
+
+  // Primaries in mm, ns and MeV, at full double precision so that the
+  // replay shoots exactly the recorded particles
+  std::streamsize precision = out.precision(17);
+  for (G4int v=0; v<event->GetNumberOfPrimaryVertex(); ++v) {
+    G4PrimaryVertex* vertex = event->GetPrimaryVertex(v);
+    out << "vertex " << vertex->GetX0() << ' ' << vertex->GetY0() << ' ' << vertex->GetZ0()
+        << ' ' << vertex->GetT0() << ' ' << vertex->GetWeight() << '\n';
+    for (G4int p=0; p<vertex->GetNumberOfParticle(); ++p) {
+      G4PrimaryParticle* particle = vertex->GetPrimary(p);
+      out << "particle " << particle->GetPDGcode() << ' ' << particle->GetPx() << ' '
+          << particle->GetPy() << ' ' << particle->GetPz() << '\n';
+    }
+  }
+  out.precision(precision);
+
+  std::vector<std::pair<G4int, const G4LogicalVolume*> > order;
+  for (const auto& entry : steps) order.push_back(std::make_pair(entry.second, entry.first));
+  std::sort(order.rbegin(), order.rend());
+  for (const auto& entry : order) 
+    out << "steps " << (entry.second ? entry.second->GetName() : G4String("OutOfWorld"))
+        << ' ' << entry.first << '\n';
+
+  out << "engine\n" << event->GetRandomNumberStatus();
+
+  G4cout << "SlowEventMonitor: event " << event->GetEventID() << " took " << time/CLHEP::ms
+         << " ms, saved to " << name.str() << G4endl;
+}
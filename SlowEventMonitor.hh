@@ -0,0 +1,54 @@
+#ifndef SlowEventMonitor_h
+#define SlowEventMonitor_h 1
+
+#include "globals.hh"
+
+#include <chrono>
+#include <unordered_map>
+
+class G4Event;
+class G4LogicalVolume;
+class G4GenericMessenger;
+
+// Wall time of every event, and a record of each event slower than the
+// threshold: its primaries, steps per logical volume and the random engine
+// state it started from, written to <prefix>_run<r>_evt<e>.slow. Such a
+// record is replayed exactly by /cosmic/gun/replay. One monitor per thread.
+class SlowEventMonitor {
+
+public:
+
+  SlowEventMonitor();
+  ~SlowEventMonitor();
+
+  void BeginEvent();
+  inline void CountStep(const G4LogicalVolume* volume);
+
+  // Returns the wall time of the event, in G4 time units
+  G4double EndEvent(const G4Event* event);
+
+  // Zero switches the capture off. The engine state is only kept with the
+  // event while capture is on.
+  void SetThreshold(G4double val);
+
+private:
+
+  typedef std::chrono::steady_clock Clock;
+
+  void Save(const G4Event* event, G4double time) const;
+
+  G4double          threshold;
+  G4String          prefix;
+  Clock::time_point start;
+
+  std::unordered_map<const G4LogicalVolume*, G4int> steps;
+
+  G4GenericMessenger* messenger;
+};
+
+
+inline void SlowEventMonitor::CountStep(const G4LogicalVolume* volume) {
+  if (threshold > 0) ++steps[volume];
+}
+
+#endif
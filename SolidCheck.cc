@@ -0,0 +1,85 @@
+#include "SolidCheck.hh"
+
+#include "G4QuickRand.hh"
+#include "G4ThreeVector.hh"
+#include "G4Timer.hh"
+#include "G4VSolid.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+  G4double TimeQueries(const G4VSolid& solid, const std::vector<G4ThreeVector>& points,
+                       const std::vector<G4ThreeVector>& dirs, const std::vector<EInside>& inside,
+                       G4double& sink) {
+
+    G4Timer timer;
+    timer.Start();
+    for (size_t i=0; i<points.size(); ++i) {
+      sink += solid.Inside(points[i]);
+      sink += solid.DistanceToIn(points[i]);
+      sink += solid.DistanceToOut(points[i]);
+      sink += (inside[i] == kOutside) ? solid.DistanceToIn(points[i], dirs[i])
+                                      : solid.DistanceToOut(points[i], dirs[i]);
+    }
+    timer.Stop();
+    return timer.GetRealElapsed()*CLHEP::s;
+  }
+}
+
+
+G4int SolidCheck::Compare(const G4VSolid& solid, const G4VSolid& reference, G4int nPoints,
+                          G4double& time, G4double& timeReference) {
+
+  G4ThreeVector bmin, bmax;
+  solid.BoundingLimits(bmin, bmax);
+  G4ThreeVector centre = 0.5*(bmin + bmax);
+  G4ThreeVector half   = 0.6*(bmax - bmin);
+
+  std::vector<G4ThreeVector> points(nPoints), dirs(nPoints);
+  std::vector<EInside> inside(nPoints);
+  for (G4int i=0; i<nPoints; ++i) {
+    if (i % 4 == 3) {
+      points[i] = solid.GetPointOnSurface();
+    } else {
+      points[i].set(centre.x() + half.x()*(2*G4QuickRand() - 1),
+                    centre.y() + half.y()*(2*G4QuickRand() - 1),
+                    centre.z() + half.z()*(2*G4QuickRand() - 1));
+    }
+    G4double cost = 2*G4QuickRand() - 1;
+    G4double sint = std::sqrt((1 - cost)*(1 + cost));
+    G4double phi  = CLHEP::twopi*G4QuickRand();
+    dirs[i].set(sint*std::cos(phi), sint*std::sin(phi), cost);
+    inside[i] = reference.Inside(points[i]);
+  }
+
+  G4int nBad = 0;
+  G4double tolerance = solid.GetTolerance();
+  for (G4int i=0; i<nPoints; ++i) {
+    const G4ThreeVector& p = points[i];
+    const G4ThreeVector& v = dirs[i];
+    G4bool bad = (solid.Inside(p) != inside[i]);
+    bad |= std::abs(solid.DistanceToIn(p)  - reference.DistanceToIn(p))  > tolerance;
+    bad |= std::abs(solid.DistanceToOut(p) - reference.DistanceToOut(p)) > tolerance;
+    if (inside[i] == kOutside) {
+      G4double d1 = solid.DistanceToIn(p, v), d2 = reference.DistanceToIn(p, v);
+      bad |= (d1 != d2) && std::abs(d1 - d2) > tolerance;
+    } else {
+      G4bool valid1, valid2;
+      G4ThreeVector n1, n2;
+      G4double d1 = solid.DistanceToOut(p, v, true, &valid1, &n1);
+      G4double d2 = reference.DistanceToOut(p, v, true, &valid2, &n2);
+      bad |= std::abs(d1 - d2) > tolerance || (d1 > tolerance && n1.dot(n2) < 1 - 1e-9);
+    }
+    if (bad) ++nBad;
+  }
+
+  G4double sink = 0;
+  time          = TimeQueries(solid,     points, dirs, inside, sink);
+  timeReference = TimeQueries(reference, points, dirs, inside, sink);
+  if (sink == -1) G4cout << sink << G4endl;
+  return nBad;
+}
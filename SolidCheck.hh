@@ -0,0 +1,27 @@
+#ifndef SolidCheck_h
+#define SolidCheck_h 1
+
+#include "globals.hh"
+
+class G4VSolid;
+
+// Consistency and speed check of a specialised solid against the
+// equivalent general Geant4 construction.
+//
+// Points are drawn in a box 20% larger than the bounding box of the solid,
+// one in four on its surface, with isotropic directions. Inside, both
+// safeties and the distance along the direction with its exit normal must
+// agree within the surface tolerance. The same query mix is then timed on
+// both solids.
+struct SolidCheck {
+
+  // Inside, both safeties and one distance per point
+  static const G4int kQueriesPerPoint = 4;
+
+  // Returns the number of points where the solids disagree. The time spent
+  // in the queries of each solid is returned in Geant4 time units.
+  static G4int Compare(const G4VSolid& solid, const G4VSolid& reference, G4int nPoints,
+                       G4double& time, G4double& timeReference);
+};
+
+#endif
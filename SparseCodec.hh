@@ -0,0 +1,98 @@
+#ifndef SparseCodec_h
+#define SparseCodec_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// Sparse per-event tile encoding: one bit per tile in 64-bit words, plus the
+// values of the set bits packed in tile order. With AVX-512 the packing uses
+// compress/expand on 16 tiles at a time, otherwise set bits are walked with
+// count-trailing-zeros.
+class SparseCodec {
+
+public:
+
+  static G4int Words(G4int nTiles) { return (nTiles + 63)/64; }
+
+  static G4int Count(const uint64_t* mask, G4int nWords) {
+    G4int n = 0;
+    for (G4int w=0; w<nWords; ++w) n += __builtin_popcountll(mask[w]);
+    return n;
+  }
+
+  // Does the event have a bit in common with every one of the given masks?
+  static G4bool HitsAll(const uint64_t* mask, const uint64_t* const* required,
+                        G4int nRequired, G4int nWords) {
+    for (G4int r=0; r<nRequired; ++r) {
+      uint64_t any = 0;
+      for (G4int w=0; w<nWords; ++w) any |= mask[w] & required[r][w];
+      if (!any) return false;
+    }
+    return true;
+  }
+
+  // Dense edep/time over nTiles -> mask and packed values of tiles with
+  // edep > 0. Packed arrays need room for nTiles. Returns the hit count.
+  static G4int Encode(const float* edep, const float* time, G4int nTiles,
+                      uint64_t* mask, float* packedEdep, float* packedTime) {
+    G4int n = 0;
+    for (G4int w=0; w<Words(nTiles); ++w) mask[w] = 0;
+#if defined(__AVX512F__)
+    const __m512 zero = _mm512_setzero_ps();
+    for (G4int k=0; k<nTiles; k+=16) {
+      __mmask16 valid = (nTiles - k >= 16) ? (__mmask16)0xffff : (__mmask16)((1u << (nTiles - k)) - 1);
+      __m512 e = _mm512_maskz_loadu_ps(valid, edep + k);
+      __m512 t = _mm512_maskz_loadu_ps(valid, time + k);
+      __mmask16 hit = _mm512_mask_cmp_ps_mask(valid, e, zero, _CMP_GT_OQ);
+      _mm512_mask_compressstoreu_ps(packedEdep + n, hit, e);
+      _mm512_mask_compressstoreu_ps(packedTime + n, hit, t);
+      mask[k >> 6] |= (uint64_t)hit << (k & 63);
+      n += __builtin_popcount(hit);
+    }
+#else
+    for (G4int k=0; k<nTiles; ++k) mask[k >> 6] |= (uint64_t)(edep[k] > 0) << (k & 63);
+    for (G4int w=0; w<Words(nTiles); ++w) {
+      for (uint64_t bits = mask[w]; bits; bits &= bits - 1) {
+        G4int k = 64*w + __builtin_ctzll(bits);
+        packedEdep[n] = edep[k];
+        packedTime[n] = time[k];
+        ++n;
+      }
+    }
+#endif
+    return n;
+  }
+
+  // Inverse of Encode; tiles without a bit get zero edep and time
+  static void Decode(const uint64_t* mask, G4int nTiles, const float* packedEdep,
+                     const float* packedTime, float* edep, float* time) {
+#if defined(__AVX512F__)
+    G4int n = 0;
+    for (G4int k=0; k<nTiles; k+=16) {
+      __mmask16 valid = (nTiles - k >= 16) ? (__mmask16)0xffff : (__mmask16)((1u << (nTiles - k)) - 1);
+      __mmask16 hit = (__mmask16)(mask[k >> 6] >> (k & 63)) & valid;
+      _mm512_mask_storeu_ps(edep + k, valid, _mm512_maskz_expandloadu_ps(hit, packedEdep + n));
+      _mm512_mask_storeu_ps(time + k, valid, _mm512_maskz_expandloadu_ps(hit, packedTime + n));
+      n += __builtin_popcount(hit);
+    }
+#else
+    for (G4int k=0; k<nTiles; ++k) edep[k] = time[k] = 0;
+    G4int n = 0;
+    for (G4int w=0; w<Words(nTiles); ++w) {
+      for (uint64_t bits = mask[w]; bits; bits &= bits - 1) {
+        G4int k = 64*w + __builtin_ctzll(bits);
+        edep[k] = packedEdep[n];
+        time[k] = packedTime[n];
+        ++n;
+      }
+    }
+#endif
+  }
+};
+
+#endif
@@ -0,0 +1,58 @@
+#include "StackingAction.hh"
+#include "DetectorConstruction.hh"
+#include "RunAction.hh"
+
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4StackManager.hh"
+#include "G4GenericMessenger.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <cfloat>
+
+StackingAction::StackingAction(const DetectorConstruction* det, RunAction* run)
+  : G4UserStackingAction(), detector(det), runAction(run), enabled(true),
+    dropWaiting(false), minStoppingPower(0.2*CLHEP::MeV/CLHEP::m) {
+
+  messenger = new G4GenericMessenger(this, "/cosmic/stack/", "Geometry-aware stacking");
+  messenger->DeclareProperty("enable", enabled, "Classify secondaries against the tile hull");
+  messenger->DeclareProperty("dropWaiting", dropWaiting,
+                             "Discard tracks whose straight line misses every tile");
+  messenger->DeclarePropertyWithUnit("minStoppingPower", "MeV/cm", minStoppingPower,
+                                     "Lowest dE/dx assumed when estimating the reach of charged tracks");
+}
+
+
+StackingAction::~StackingAction() {
+  delete messenger;
+}
+
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track) {
+
+  if (!enabled || track->GetParentID() == 0) return fUrgent;
+
+  const TileHull& hull = detector->GetTileHull();
+  const G4ThreeVector& pos = track->GetPosition();
+
+  G4double reach = DBL_MAX;
+  if (track->GetDefinition()->GetPDGCharge() != 0) 
+    reach = track->GetKineticEnergy()/minStoppingPower;
+
+  G4ClassificationOfNewTrack classification = fUrgent;
+  if (hull.Distance(pos) > reach) {
+    classification = fKill;
+  } else if (!hull.Intersects(pos, track->GetMomentumDirection(), reach)) {
+    classification = fWaiting;
+  }
+
+  runAction->CountStackedTrack(classification);
+  return classification;
+}
+
+
+void StackingAction::NewStage() {
+
+  if (dropWaiting) stackManager->clear();
+}
@@ -0,0 +1,37 @@
+#ifndef StackingAction_h
+#define StackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+class DetectorConstruction;
+class RunAction;
+class G4GenericMessenger;
+
+// Classifies new secondaries against the tile hull. Tracks whose energy
+// based reach cannot get them to any tile are killed; tracks that could
+// only get there by scattering, because their straight line misses the
+// hull, are moved to the waiting stack.
+class StackingAction : public G4UserStackingAction {
+
+public:
+
+  StackingAction(const DetectorConstruction* det, RunAction* run);
+  virtual ~StackingAction();
+
+  virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+  virtual void NewStage();
+
+private:
+
+  const DetectorConstruction* detector;
+  RunAction*                  runAction;
+
+  G4bool   enabled;
+  G4bool   dropWaiting;
+  G4double minStoppingPower;
+
+  G4GenericMessenger* messenger;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#include "SteppingAction.hh"
+#include "DetectorConstruction.hh"
+#include "EventAction.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+SteppingAction::SteppingAction(const DetectorConstruction* det, EventAction* event)
+  : G4UserSteppingAction(), detector(det), eventAction(event),
+    metrics(MetricsExporter::GetThreadCounters()) {}
+
+
+SteppingAction::~SteppingAction() {}
+
+
+void SteppingAction::UserSteppingAction(const G4Step* step) {
+
+  MetricsExporter::ThreadCounters::Increment(metrics->steps);
+  profiler.Count(step);
+  eventAction->GetSlowEventMonitor().CountStep(step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume());
+
+  const G4StepPoint* pre = step->GetPreStepPoint();
+  G4double edep = step->GetTotalEnergyDeposit();
+  if (edep > 0) {
+    G4int tile = detector->GetTileId(pre->GetTouchable());
+    if (tile >= 0) {
+      eventAction->AddEdep(tile, edep, pre->GetGlobalTime());
+    } else {
+      G4int pmt = detector->GetPmtId(pre->GetTouchable());
+      if (pmt >= 0) eventAction->AddPmtEdep(pmt, edep);
+    }
+  }
+
+  if (stuckTracks.Check(step)) return;
+
+  // Anything leaving the detector volume into the world air is lost
+  G4Track* track = step->GetTrack();
+  const G4StepPoint* post = step->GetPostStepPoint();
+  if (detector->IsKillerVolume(post->GetPhysicalVolume()) &&
+      !detector->IsKillerVolume(pre->GetPhysicalVolume())) {
+    track->SetTrackStatus(fStopAndKill);
+    return;
+  }
+
+  // Only the primary decides whether a coincidence is still possible
+  if (track->GetParentID() != 0) return;
+
+  CoincidenceTrigger& trigger = eventAction->GetTrigger();
+  if (!trigger.Fired() &&
+      trigger.IsImpossible(post->GetPosition(), track->GetMomentumDirection())) {
+    eventAction->AbortEvent();
+  }
+}
@@ -0,0 +1,31 @@
+#ifndef SteppingAction_h
+#define SteppingAction_h 1
+
+#include "G4UserSteppingAction.hh"
+#include "MetricsExporter.hh"
+#include "SteppingProfiler.hh"
+#include "StuckTrackMonitor.hh"
+#include "globals.hh"
+
+class DetectorConstruction;
+class EventAction;
+
+class SteppingAction : public G4UserSteppingAction {
+
+public:
+
+  SteppingAction(const DetectorConstruction* det, EventAction* event);
+  virtual ~SteppingAction();
+
+  virtual void UserSteppingAction(const G4Step*);
+
+private:
+
+  const DetectorConstruction* detector;
+  EventAction*                eventAction;
+  SteppingProfiler            profiler;
+  StuckTrackMonitor           stuckTracks;
+  MetricsExporter::ThreadCounters* metrics;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#include "SteppingProfiler.hh"
+
+#include "G4AutoLock.hh"
+#include "G4GenericMessenger.hh"
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VProcess.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace {
+  G4Mutex registryMutex = G4MUTEX_INITIALIZER;
+  std::vector<SteppingProfiler*> registry;
+}
+
+
+SteppingProfiler::SteppingProfiler()
+  : enabled(false), sampleEvery(64), untilSample(64), timing(false), lastCounts(0) {
+
+  lastKey.volume = 0;
+  lastKey.particle = 0;
+  lastKey.process = 0;
+
+  messenger = new G4GenericMessenger(this, "/cosmic/profile/", "Stepping profiler");
+  messenger->DeclareMethod("enable", &SteppingProfiler::SetEnabled,
+                           "Count steps per volume, particle and process");
+  messenger->DeclareMethod("sampleEvery", &SteppingProfiler::SetSampleEvery,
+                           "Time one step in this many");
+
+  G4AutoLock lock(&registryMutex);
+  registry.push_back(this);
+}
+
+
+SteppingProfiler::~SteppingProfiler() {
+
+  delete messenger;
+
+  G4AutoLock lock(&registryMutex);
+  registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+}
+
+
+void SteppingProfiler::SetEnabled(G4bool val) {
+  enabled = val;
+  timing = false;
+}
+
+
+void SteppingProfiler::CountSlow(const G4Step* step) {
+
+  const G4StepPoint* pre = step->GetPreStepPoint();
+  Key key;
+  key.volume   = pre->GetPhysicalVolume() ? pre->GetPhysicalVolume()->GetLogicalVolume() : 0;
+  key.particle = step->GetTrack()->GetParticleDefinition();
+  key.process  = step->GetPostStepPoint()->GetProcessDefinedStep();
+
+  // Consecutive steps mostly share the key
+  if (!lastCounts || !(key == lastKey)) {
+    auto it = counts.find(key);
+    if (it == counts.end()) it = counts.emplace(key, Counts{0, 0, 0.}).first;
+    lastKey = key;
+    lastCounts = &it->second;
+  }
+  lastCounts->steps += 1;
+
+  if (timing) {
+    lastCounts->samples += 1;
+    lastCounts->sampledTime += std::chrono::duration<G4double>(Clock::now() - lastCall).count();
+    timing = false;
+  }
+  if (--untilSample <= 0) {
+    untilSample = sampleEvery;
+    timing = true;
+    lastCall = Clock::now();
+  }
+}
+
+
+void SteppingProfiler::Report(G4int nLines, const G4String& file) {
+
+  struct Total {
+    uint64_t steps, samples;
+    G4double sampledTime;
+  };
+  typedef std::tuple<G4String, G4String, G4String> Name;
+
+  G4AutoLock lock(&registryMutex);
+  std::map<Name, Total> totals;
+  G4bool any = false;
+  for (SteppingProfiler* profiler : registry) {
+    any = any || profiler->enabled;
+    for (const auto& entry : profiler->counts) {
+      const Key& k = entry.first;
+      Name name(k.volume   ? k.volume->GetName()          : G4String("OutOfWorld"),
+                k.particle ? k.particle->GetParticleName() : G4String("unknown"),
+                k.process  ? k.process->GetProcessName()   : G4String("none"));
+      Total& t = totals[name];
+      t.steps       += entry.second.steps;
+      t.samples     += entry.second.samples;
+      t.sampledTime += entry.second.sampledTime;
+    }
+    profiler->counts.clear();
+    profiler->lastCounts = 0;
+  }
+  if (!any || totals.empty()) return;
+
+  // Sort by estimated time, keys that were never timed by step count
+  std::vector<std::pair<G4double, std::map<Name, Total>::const_iterator> > order;
+  uint64_t allSteps = 0;
+  G4double allTime = 0;
+  for (auto it = totals.cbegin(); it != totals.cend(); ++it) {
+    const Total& t = it->second;
+    G4double time = t.samples ? t.sampledTime*t.steps/t.samples : 0.;
+    order.push_back(std::make_pair(time, it));
+    allSteps += t.steps;
+    allTime += time;
+  }
+  std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+    return (a.first != b.first) ? a.first > b.first : a.second->second.steps > b.second->second.steps;
+  });
+
+  auto write = [&](std::ostream& out, size_t lines) {
+    out << std::left << std::setw(20) << "volume" << std::setw(12) << "particle"
+        << std::setw(20) << "process" << std::right << std::setw(14) << "steps"
+        << std::setw(9) << "% steps" << std::setw(12) << "time [s]" << std::setw(9) << "% time" << "\n";
+    for (size_t i=0; i<std::min(lines, order.size()); ++i) {
+      const Name& name = order[i].second->first;
+      const Total& t = order[i].second->second;
+      out << std::left << std::setw(20) << std::get<0>(name) << std::setw(12) << std::get<1>(name)
+          << std::setw(20) << std::get<2>(name) << std::right << std::setw(14) << t.steps
+          << std::setw(9) << std::setprecision(3) << 100.*t.steps/allSteps
+          << std::setw(12) << order[i].first
+          << std::setw(9) << (allTime > 0 ? 100.*order[i].first/allTime : 0.) << "\n";
+    }
+  };
+
+  G4cout << "SteppingProfiler: " << allSteps << " steps, about " << allTime 
+         << " s in stepping (summed over threads)" << G4endl;
+  write(G4cout, nLines);
+  if (!file.empty()) {
+    std::ofstream out(file.c_str());
+    write(out, order.size());
+  }
+}
@@ -0,0 +1,83 @@
+#ifndef SteppingProfiler_h
+#define SteppingProfiler_h 1
+
+#include "globals.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+
+class G4Step;
+class G4GenericMessenger;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+
+// Opt-in count of steps per (logical volume, particle, limiting process),
+// one profiler per thread so counting takes no locks. Every sampleEvery-th
+// step is also timed, from the end of the previous stepping action call to
+// this one, and the time of a key is estimated as its mean sampled step
+// time times its step count. Profilers register themselves; the master
+// merges them by name at run end and reports the keys by estimated time.
+class SteppingProfiler {
+
+public:
+
+  SteppingProfiler();
+  ~SteppingProfiler();
+
+  void SetEnabled(G4bool val);
+  void SetSampleEvery(G4int val) { sampleEvery = val > 0 ? val : 1; }
+  G4bool IsEnabled() const { return enabled; }
+
+  inline void Count(const G4Step* step);
+
+  // Merge all profilers, print the first nLines keys and write the full
+  // table to file unless it is empty, then clear the counts
+  static void Report(G4int nLines, const G4String& file);
+
+private:
+
+  typedef std::chrono::steady_clock Clock;
+
+  struct Key {
+    const G4LogicalVolume*      volume;
+    const G4ParticleDefinition* particle;
+    const G4VProcess*           process;
+    G4bool operator==(const Key& k) const {
+      return volume == k.volume && particle == k.particle && process == k.process;
+    }
+  };
+  struct KeyHash {
+    size_t operator()(const Key& k) const {
+      return std::hash<const void*>()(k.volume) ^ (std::hash<const void*>()(k.particle) << 1)
+        ^ (std::hash<const void*>()(k.process) << 2);
+    }
+  };
+  struct Counts {
+    uint64_t steps;
+    uint64_t samples;
+    G4double sampledTime;
+  };
+
+  void CountSlow(const G4Step* step);
+
+  G4bool enabled;
+  G4int  sampleEvery;
+  G4int  untilSample;
+  G4bool timing;
+  Clock::time_point lastCall;
+
+  std::unordered_map<Key, Counts, KeyHash> counts;
+  Key     lastKey;
+  Counts* lastCounts;
+
+  G4GenericMessenger* messenger;
+};
+
+
+inline void SteppingProfiler::Count(const G4Step* step) {
+  if (enabled) CountSlow(step);
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "StuckTrackMonitor.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <sstream>
+
+StuckTrackMonitor::StuckTrackMonitor() 
+  : enabled(false), kill(false), zeroStepLimit(50), volumeStepLimit(100000), maxReports(20),
+    tolerance(G4GeometryTolerance::GetInstance()->GetSurfaceTolerance()),
+    track(0), volume(0), zeroSteps(0), volumeSteps(0), reported(false), nReports(0) {
+
+  messenger = new G4GenericMessenger(this, "/cosmic/stuck/", "Stuck track detection");
+  messenger->DeclareProperty("enable", enabled, "Watch tracks for stuck navigation, off by default");
+  messenger->DeclareProperty("kill", kill, "Kill tracks that trip a limit");
+  messenger->DeclareProperty("zeroStepLimit", zeroStepLimit,
+                             "Consecutive steps shorter than the surface tolerance");
+  messenger->DeclareProperty("volumeStepLimit", volumeStepLimit,
+                             "Steps of one track in one volume");
+  messenger->DeclareProperty("maxReports", maxReports, "Reports per thread before going quiet");
+}
+
+
+StuckTrackMonitor::~StuckTrackMonitor() {
+  delete messenger;
+}
+
+
+G4bool StuckTrackMonitor::Check(const G4Step* step) {
+
+  if (!enabled) return false;
+
+  const G4Track* current = step->GetTrack();
+  const G4VPhysicalVolume* pv = step->GetPreStepPoint()->GetPhysicalVolume();
+  if (current != track || current->GetCurrentStepNumber() == 1) {
+    track = current;
+    volume = pv;
+    zeroSteps = volumeSteps = 0;
+    reported = false;
+  } else if (pv != volume) {
+    volume = pv;
+    volumeSteps = 0;
+  }
+
+  zeroSteps = (step->GetStepLength() < tolerance) ? zeroSteps + 1 : 0;
+  ++volumeSteps;
+  if (zeroSteps < zeroStepLimit && volumeSteps < volumeStepLimit) return false;
+
+  if (!reported) {
+    std::ostringstream reason;
+    if (zeroSteps >= zeroStepLimit) reason << zeroSteps << " consecutive steps below tolerance";
+    else                            reason << volumeSteps << " steps in one volume";
+    Report(step, reason.str());
+    reported = true;
+  }
+  if (!kill) return false;
+
+  step->GetTrack()->SetTrackStatus(fStopAndKill);
+  return true;
+}
+
+
+void StuckTrackMonitor::Report(const G4Step* step, const G4String& reason) const {
+
+  if (++nReports > maxReports) return;
+
+  const G4StepPoint* pre  = step->GetPreStepPoint();
+  const G4StepPoint* post = step->GetPostStepPoint();
+  const G4VPhysicalVolume* from = pre->GetPhysicalVolume();
+  const G4VPhysicalVolume* to   = post->GetPhysicalVolume();
+  const G4ThreeVector& pos = post->GetPosition();
+
+  std::ostringstream message;
+  message << "Track " << step->GetTrack()->GetTrackID() << " ("
+          << step->GetTrack()->GetParticleDefinition()->GetParticleName() << "): " << reason
+          << " between " << (from ? from->GetName() : G4String("OutOfWorld")) << " #" 
+          << (from ? from->GetCopyNo() : -1) << " and "
+          << (to ? to->GetName() : G4String("OutOfWorld")) << " #" << (to ? to->GetCopyNo() : -1)
+          << " at (" << pos.x()/CLHEP::cm << ", " << pos.y()/CLHEP::cm << ", " 
+          << pos.z()/CLHEP::cm << ") cm" << (kill ? ", killed" : "");
+  if (nReports == maxReports) message << ". Further reports are suppressed.";
+  G4Exception("StuckTrackMonitor::Check", "Stuck001", JustWarning, message.str().c_str());
+}
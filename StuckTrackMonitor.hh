@@ -0,0 +1,49 @@
+#ifndef StuckTrackMonitor_h
+#define StuckTrackMonitor_h 1
+
+#include "globals.hh"
+
+class G4Step;
+class G4Track;
+class G4VPhysicalVolume;
+class G4GenericMessenger;
+
+// Watches for tracks the navigator cannot move on: runs of consecutive
+// steps shorter than the surface tolerance, typically at surfaces shared
+// by touching placements, or too many steps in one volume. The first time
+// a track trips a limit the volume pair and global position are reported,
+// and with kill set the track is stopped there. Off unless switched on
+// with /cosmic/stuck/enable, and it only reports unless kill is set as
+// well. One monitor per thread.
+class StuckTrackMonitor {
+
+public:
+
+  StuckTrackMonitor();
+  ~StuckTrackMonitor();
+
+  // True if the track was killed
+  G4bool Check(const G4Step* step);
+
+private:
+
+  void Report(const G4Step* step, const G4String& reason) const;
+
+  G4bool   enabled;
+  G4bool   kill;
+  G4int    zeroStepLimit;
+  G4int    volumeStepLimit;
+  G4int    maxReports;
+  G4double tolerance;
+
+  const G4Track*           track;
+  const G4VPhysicalVolume* volume;
+  G4int  zeroSteps;
+  G4int  volumeSteps;
+  G4bool reported;
+  mutable G4int nReports;
+
+  G4GenericMessenger* messenger;
+};
+
+#endif
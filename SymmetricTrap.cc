@@ -0,0 +1,314 @@
+#include "SymmetricTrap.hh"
+#include "SolidCheck.hh"
+
+#include "G4BoundingEnvelope.hh"
+#include "G4Polyhedron.hh"
+#include "G4QuickRand.hh"
+#include "G4Trap.hh"
+#include "G4VGraphicsScene.hh"
+#include "G4VoxelLimits.hh"
+#include "G4AffineTransform.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+SymmetricTrap::SymmetricTrap(const G4String& name, G4double dz, G4double dy, G4double bl1, G4double bl2)
+  : G4CSGSolid(name), fDz(dz), fDy(dy), fBl1(bl1), fBl2(bl2) {
+
+  fHalfTolerance = 0.5*kCarTolerance;
+  if (fDz < 2*kCarTolerance || fDy < 2*kCarTolerance ||
+      fBl1 < 2*kCarTolerance || fBl2 < 2*kCarTolerance) {
+    G4Exception("SymmetricTrap::SymmetricTrap", "Geom001", FatalException,
+                ("Invalid half lengths for solid " + name).c_str());
+  }
+
+  fSlope      = 0.5*(fBl2 - fBl1)/fDz;
+  fSideNormal = 1./std::sqrt(1. + fSlope*fSlope);
+  fSideOffset = 0.5*(fBl1 + fBl2)*fSideNormal;
+}
+
+
+SymmetricTrap::SymmetricTrap(const SymmetricTrap& rhs)
+  : G4CSGSolid(rhs), fDz(rhs.fDz), fDy(rhs.fDy), fBl1(rhs.fBl1), fBl2(rhs.fBl2),
+    fSlope(rhs.fSlope), fSideNormal(rhs.fSideNormal), fSideOffset(rhs.fSideOffset),
+    fHalfTolerance(rhs.fHalfTolerance) {}
+
+
+SymmetricTrap& SymmetricTrap::operator=(const SymmetricTrap& rhs) {
+
+  if (this == &rhs) return *this;
+  G4CSGSolid::operator=(rhs);
+  fDz            = rhs.fDz;
+  fDy            = rhs.fDy;
+  fBl1           = rhs.fBl1;
+  fBl2           = rhs.fBl2;
+  fSlope         = rhs.fSlope;
+  fSideNormal    = rhs.fSideNormal;
+  fSideOffset    = rhs.fSideOffset;
+  fHalfTolerance = rhs.fHalfTolerance;
+  return *this;
+}
+
+
+SymmetricTrap::~SymmetricTrap() {}
+
+
+EInside SymmetricTrap::Inside(const G4ThreeVector& p) const {
+
+  G4double dist = SignedDistance(p);
+  return (dist > fHalfTolerance) ? kOutside : ((dist > -fHalfTolerance) ? kSurface : kInside);
+}
+
+
+G4ThreeVector SymmetricTrap::SurfaceNormal(const G4ThreeVector& p) const {
+
+  G4double sz = (p.z() < 0) ? -1. : 1.;
+  G4double sy = (p.y() < 0) ? -1. : 1.;
+  G4double sx = (p.x() < 0) ? -1. : 1.;
+  G4double dz = std::abs(p.z()) - fDz;
+  G4double dy = std::abs(p.y()) - fDy;
+  G4double dx = SideDistance(p);
+  G4ThreeVector nz(0, 0, sz);
+  G4ThreeVector ny(0, sy, 0);
+  G4ThreeVector nx(sx*fSideNormal, 0, -fSlope*fSideNormal);
+
+  G4int nsurf = 0;
+  G4ThreeVector sum;
+  if (std::abs(dz) <= fHalfTolerance) { sum += nz; ++nsurf; }
+  if (std::abs(dy) <= fHalfTolerance) { sum += ny; ++nsurf; }
+  if (std::abs(dx) <= fHalfTolerance) { sum += nx; ++nsurf; }
+  if (nsurf == 1) return sum;
+  if (nsurf > 1)  return sum.unit();
+
+  // Not on the surface, take the face the point is furthest outside of
+  if (dz >= dy && dz >= dx) return nz;
+  return (dy >= dx) ? ny : nx;
+}
+
+
+G4double SymmetricTrap::DistanceToIn(const G4ThreeVector& p, const G4ThreeVector& v) const {
+
+  // Z and Y slabs
+  if ((std::abs(p.z()) - fDz) >= -fHalfTolerance && p.z()*v.z() >= 0) return kInfinity;
+  if ((std::abs(p.y()) - fDy) >= -fHalfTolerance && p.y()*v.y() >= 0) return kInfinity;
+
+  G4double invz = (-v.z() == 0) ? DBL_MAX : -1./v.z();
+  G4double dz   = (invz < 0) ? fDz : -fDz;
+  G4double tmin = (p.z() + dz)*invz;
+  G4double tmax = (p.z() - dz)*invz;
+
+  G4double invy = (-v.y() == 0) ? DBL_MAX : -1./v.y();
+  G4double dy   = (invy < 0) ? fDy : -fDy;
+  tmin = std::max(tmin, (p.y() + dy)*invy);
+  tmax = std::min(tmax, (p.y() - dy)*invy);
+
+  // Side planes, the x<0 one is the mirror image of the x>0 one
+  G4double cosx = fSideNormal*v.x();
+  G4double cosz = -fSlope*fSideNormal*v.z();
+  G4double disx = fSideNormal*p.x();
+  G4double disz = -fSlope*fSideNormal*p.z() - fSideOffset;
+  for (G4int s=-1; s<=1; s+=2) {
+    G4double cosa = s*cosx + cosz;
+    G4double dist = s*disx + disz;
+    if (dist >= -fHalfTolerance) {
+      if (cosa >= 0) return kInfinity;
+      tmin = std::max(tmin, -dist/cosa);
+    } else if (cosa > 0) {
+      tmax = std::min(tmax, -dist/cosa);
+    }
+  }
+
+  if (tmax <= tmin + fHalfTolerance) return kInfinity;
+  return (tmin < fHalfTolerance) ? 0. : tmin;
+}
+
+
+G4double SymmetricTrap::DistanceToIn(const G4ThreeVector& p) const {
+
+  G4double dist = SignedDistance(p);
+  return (dist > 0) ? dist : 0.;
+}
+
+
+G4double SymmetricTrap::DistanceToOut(const G4ThreeVector& p, const G4ThreeVector& v,
+                                      const G4bool calcNorm, G4bool* validNorm,
+                                      G4ThreeVector* n) const {
+
+  // Leaving through a face the point is already on
+  if ((std::abs(p.z()) - fDz) >= -fHalfTolerance && p.z()*v.z() > 0) {
+    if (calcNorm) { *validNorm = true; n->set(0, 0, (p.z() < 0) ? -1 : 1); }
+    return 0.;
+  }
+  if ((std::abs(p.y()) - fDy) >= -fHalfTolerance && p.y()*v.y() > 0) {
+    if (calcNorm) { *validNorm = true; n->set(0, (p.y() < 0) ? -1 : 1, 0); }
+    return 0.;
+  }
+
+  // 0 = z face, 1 = y face, 2/4 = side on x<0 / x>0
+  G4int iside = 0;
+  G4double tmax = (v.z() == 0) ? DBL_MAX : (std::copysign(fDz, v.z()) - p.z())/v.z();
+  if (v.y() != 0) {
+    G4double tmp = (std::copysign(fDy, v.y()) - p.y())/v.y();
+    if (tmp < tmax) { tmax = tmp; iside = 1; }
+  }
+
+  G4double cosx = fSideNormal*v.x();
+  G4double cosz = -fSlope*fSideNormal*v.z();
+  G4double disx = fSideNormal*p.x();
+  G4double disz = -fSlope*fSideNormal*p.z() - fSideOffset;
+  for (G4int s=-1; s<=1; s+=2) {
+    G4double cosa = s*cosx + cosz;
+    if (cosa <= 0) continue;
+    G4double dist = s*disx + disz;
+    if (dist >= -fHalfTolerance) {
+      if (calcNorm) { *validNorm = true; n->set(s*fSideNormal, 0, -fSlope*fSideNormal); }
+      return 0.;
+    }
+    G4double tmp = -dist/cosa;
+    if (tmp < tmax) { tmax = tmp; iside = s + 3; }
+  }
+
+  if (calcNorm) {
+    *validNorm = true;
+    switch (iside) {
+      case 0:  n->set(0, 0, (v.z() < 0) ? -1 : 1); break;
+      case 1:  n->set(0, (v.y() < 0) ? -1 : 1, 0); break;
+      default: n->set((iside - 3)*fSideNormal, 0, -fSlope*fSideNormal); break;
+    }
+  }
+  return tmax;
+}
+
+
+G4double SymmetricTrap::DistanceToOut(const G4ThreeVector& p) const {
+
+  G4double dist = SignedDistance(p);
+  return (dist < 0) ? -dist : 0.;
+}
+
+
+void SymmetricTrap::BoundingLimits(G4ThreeVector& pMin, G4ThreeVector& pMax) const {
+
+  G4double xmax = std::max(fBl1, fBl2);
+  pMin.set(-xmax, -fDy, -fDz);
+  pMax.set( xmax,  fDy,  fDz);
+}
+
+
+G4bool SymmetricTrap::CalculateExtent(const EAxis pAxis, const G4VoxelLimits& pVoxelLimit,
+                                      const G4AffineTransform& pTransform,
+                                      G4double& pMin, G4double& pMax) const {
+
+  G4ThreeVector bmin, bmax;
+  BoundingLimits(bmin, bmax);
+  G4BoundingEnvelope bbox(bmin, bmax);
+  if (bbox.BoundingBoxVsVoxelLimits(pAxis, pVoxelLimit, pTransform, pMin, pMax)) {
+    return (pMin < pMax) ? true : false;
+  }
+
+  // The two z faces as polygons of the bounding envelope
+  G4ThreeVectorList baseA(4), baseB(4);
+  baseA[0].set(-fBl1, -fDy, -fDz);
+  baseA[1].set( fBl1, -fDy, -fDz);
+  baseA[2].set( fBl1,  fDy, -fDz);
+  baseA[3].set(-fBl1,  fDy, -fDz);
+  baseB[0].set(-fBl2, -fDy,  fDz);
+  baseB[1].set( fBl2, -fDy,  fDz);
+  baseB[2].set( fBl2,  fDy,  fDz);
+  baseB[3].set(-fBl2,  fDy,  fDz);
+  std::vector<const G4ThreeVectorList*> polygons(2);
+  polygons[0] = &baseA;
+  polygons[1] = &baseB;
+  G4BoundingEnvelope benv(bmin, bmax, polygons);
+  return benv.CalculateExtent(pAxis, pVoxelLimit, pTransform, pMin, pMax);
+}
+
+
+G4double SymmetricTrap::GetCubicVolume() {
+
+  if (fCubicVolume == 0) fCubicVolume = 4*fDy*fDz*(fBl1 + fBl2);
+  return fCubicVolume;
+}
+
+
+G4double SymmetricTrap::GetSurfaceArea() {
+
+  if (fSurfaceArea == 0) {
+    G4double side = std::sqrt(4*fDz*fDz + (fBl2 - fBl1)*(fBl2 - fBl1));
+    fSurfaceArea = 4*(fDy + fDz)*(fBl1 + fBl2) + 4*fDy*side;
+  }
+  return fSurfaceArea;
+}
+
+
+G4ThreeVector SymmetricTrap::GetPointOnSurface() const {
+
+  // Face areas: -z, +z, one y face, one side
+  G4double side = std::sqrt(4*fDz*fDz + (fBl2 - fBl1)*(fBl2 - fBl1));
+  G4double area[4] = { 4*fDy*fBl1, 4*fDy*fBl2, 2*fDz*(fBl1 + fBl2), 2*fDy*side };
+  G4double select = (area[0] + area[1] + 2*area[2] + 2*area[3])*G4QuickRand();
+  G4double u = 2*G4QuickRand() - 1;
+  G4double w = 2*G4QuickRand() - 1;
+
+  if ((select -= area[0]) < 0) return G4ThreeVector(u*fBl1, w*fDy, -fDz);
+  if ((select -= area[1]) < 0) return G4ThreeVector(u*fBl2, w*fDy,  fDz);
+  if ((select -= 2*area[2]) < 0) {
+    // Uniform over the trapezoid by rejection against its bounding rectangle
+    G4double xmax = std::max(fBl1, fBl2);
+    G4double y = (select + area[2] < 0) ? -fDy : fDy;
+    for (;;) {
+      G4double z = fDz*(2*G4QuickRand() - 1);
+      G4double x = xmax*(2*G4QuickRand() - 1);
+      if (std::abs(x) <= fBl1 + fSlope*(z + fDz)) return G4ThreeVector(x, y, z);
+    }
+  }
+  G4double t = 0.5*(u + 1);
+  G4double x = ((select < area[3]) ? -1 : 1)*(fBl1 + (fBl2 - fBl1)*t);
+  return G4ThreeVector(x, w*fDy, fDz*(2*t - 1));
+}
+
+
+G4VSolid* SymmetricTrap::Clone() const {
+
+  return new SymmetricTrap(*this);
+}
+
+
+std::ostream& SymmetricTrap::StreamInfo(std::ostream& os) const {
+
+  G4int oldprc = os.precision(16);
+  os << "-----------------------------------------------------------\n"
+     << "    *** Dump for solid - " << GetName() << " ***\n"
+     << "    ===================================================\n"
+     << " Solid type: SymmetricTrap\n"
+     << " Parameters: \n"
+     << "    half length Z: " << fDz/CLHEP::mm << " mm\n"
+     << "    half length Y: " << fDy/CLHEP::mm << " mm\n"
+     << "    half length X at -Z: " << fBl1/CLHEP::mm << " mm\n"
+     << "    half length X at +Z: " << fBl2/CLHEP::mm << " mm\n"
+     << "-----------------------------------------------------------\n";
+  os.precision(oldprc);
+  return os;
+}
+
+
+void SymmetricTrap::DescribeYourselfTo(G4VGraphicsScene& scene) const {
+
+  scene.AddSolid(*this);
+}
+
+
+G4Polyhedron* SymmetricTrap::CreatePolyhedron() const {
+
+  return new G4PolyhedronTrap(fDz, 0, 0, fDy, fBl1, fBl1, 0, fDy, fBl2, fBl2, 0);
+}
+
+
+G4int SymmetricTrap::CrossCheck(G4int nPoints, G4double& timeSelf, G4double& timeTrap) const {
+
+  G4Trap trap(GetName() + "_check", fDz, 0, 0, fDy, fBl1, fBl1, 0, fDy, fBl2, fBl2, 0);
+  return SolidCheck::Compare(*this, trap, nPoints, timeSelf, timeTrap);
+}
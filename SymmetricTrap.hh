@@ -0,0 +1,83 @@
+#ifndef SymmetricTrap_h
+#define SymmetricTrap_h 1
+
+#include "G4CSGSolid.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <algorithm>
+#include <cmath>
+
+// Right prism with a symmetric trapezoid cross-section: the G4Trap of the
+// scintillator tiles, G4Trap(name, dz, 0, 0, dy, bl1, bl1, 0, dy, bl2, bl2, 0),
+// in the same frame. z runs along the tile over [-dz, dz], y across the
+// thickness over [-dy, dy], and the half width in x grows linearly from bl1
+// at -dz to bl2 at +dz.
+//
+// With the two y faces and the two z faces axis aligned and the two side
+// faces mirror images, every query reduces to |x|, |y| and |z| against
+// three planes instead of the six general planes of G4Trap.
+class SymmetricTrap : public G4CSGSolid {
+
+public:
+
+  SymmetricTrap(const G4String& name, G4double dz, G4double dy, G4double bl1, G4double bl2);
+  SymmetricTrap(const SymmetricTrap& rhs);
+  SymmetricTrap& operator=(const SymmetricTrap& rhs);
+  virtual ~SymmetricTrap();
+
+  G4double GetZHalfLength() const  { return fDz; }
+  G4double GetYHalfLength() const  { return fDy; }
+  G4double GetXHalfLength1() const { return fBl1; }
+  G4double GetXHalfLength2() const { return fBl2; }
+
+  // Largest signed distance to the six face planes, positive outside. Its
+  // magnitude is the safety on either side.
+  G4double SignedDistance(const G4ThreeVector& p) const {
+    return std::max(std::max(std::abs(p.z()) - fDz, std::abs(p.y()) - fDy), SideDistance(p));
+  }
+
+  EInside       Inside(const G4ThreeVector& p) const;
+  G4ThreeVector SurfaceNormal(const G4ThreeVector& p) const;
+  G4double      DistanceToIn(const G4ThreeVector& p, const G4ThreeVector& v) const;
+  G4double      DistanceToIn(const G4ThreeVector& p) const;
+  G4double      DistanceToOut(const G4ThreeVector& p, const G4ThreeVector& v,
+                              const G4bool calcNorm = false, G4bool* validNorm = 0,
+                              G4ThreeVector* n = 0) const;
+  G4double      DistanceToOut(const G4ThreeVector& p) const;
+
+  void   BoundingLimits(G4ThreeVector& pMin, G4ThreeVector& pMax) const;
+  G4bool CalculateExtent(const EAxis pAxis, const G4VoxelLimits& pVoxelLimit,
+                         const G4AffineTransform& pTransform, G4double& pMin, G4double& pMax) const;
+
+  G4double      GetCubicVolume();
+  G4double      GetSurfaceArea();
+  G4ThreeVector GetPointOnSurface() const;
+
+  G4GeometryType GetEntityType() const { return "SymmetricTrap"; }
+  G4VSolid*      Clone() const;
+  std::ostream&  StreamInfo(std::ostream& os) const;
+
+  void          DescribeYourselfTo(G4VGraphicsScene& scene) const;
+  G4Polyhedron* CreatePolyhedron() const;
+
+  // Compare with the equivalent G4Trap, see SolidCheck::Compare
+  G4int CrossCheck(G4int nPoints, G4double& timeSelf, G4double& timeTrap) const;
+
+private:
+
+  // Signed distance to the side planes of the |x| half, positive outside
+  G4double SideDistance(const G4ThreeVector& p) const {
+    return (std::abs(p.x()) - fSlope*p.z())*fSideNormal - fSideOffset;
+  }
+
+  G4double fDz, fDy, fBl1, fBl2;
+
+  // Side plane of x>0: (x - fSlope*z)*fSideNormal = fSideOffset
+  G4double fSlope;
+  G4double fSideNormal;
+  G4double fSideOffset;
+  G4double fHalfTolerance;
+};
+
+#endif
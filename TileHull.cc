@@ -0,0 +1,119 @@
+#include "TileHull.hh"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace {
+
+  struct Point2 { 
+    G4double x, y; 
+    bool operator<(const Point2& o) const { return x < o.x || (x == o.x && y < o.y); }
+  };
+
+  G4double Cross(const Point2& o, const Point2& a, const Point2& b) {
+    return (a.x - o.x)*(b.y - o.y) - (a.y - o.y)*(b.x - o.x);
+  }
+
+  // Andrew's monotone chain, counter-clockwise without repeated end point
+  std::vector<Point2> ConvexHull(std::vector<Point2> pts) {
+    std::sort(pts.begin(), pts.end());
+    if (pts.size() < 3) return pts;
+    std::vector<Point2> hull(2*pts.size());
+    size_t k = 0;
+    for (size_t i=0; i<pts.size(); ++i) {
+      while (k >= 2 && Cross(hull[k-2], hull[k-1], pts[i]) <= 0) --k;
+      hull[k++] = pts[i];
+    }
+    for (size_t i=pts.size()-1, t=k+1; i>0; --i) {
+      while (k >= t && Cross(hull[k-2], hull[k-1], pts[i-1]) <= 0) --k;
+      hull[k++] = pts[i-1];
+    }
+    hull.resize(k-1);
+    return hull;
+  }
+}
+
+
+TileHull::TileHull() {}
+
+
+void TileHull::Build(const std::vector<TileInfo>& tiles, G4double margin) {
+
+  std::vector<Point2> pts[kNumPlanes];
+  G4double zlo[kNumPlanes] = { DBL_MAX,  DBL_MAX};
+  G4double zhi[kNumPlanes] = {-DBL_MAX, -DBL_MAX};
+
+  for (const TileInfo& tile : tiles) {
+    for (G4int c=0; c<8; ++c) {
+      G4double z = (c & 4) ? tile.dz : -tile.dz;
+      G4double y = (c & 2) ? tile.dy : -tile.dy;
+      G4double x = ((c & 4) ? tile.bl2 : tile.bl1)*((c & 1) ? 1 : -1);
+      G4ThreeVector corner = tile.toGlobal.TransformPoint(G4ThreeVector(x, y, z));
+      Point2 pt = { corner.x(), corner.y() };
+      pts[tile.plane].push_back(pt);
+      zlo[tile.plane] = std::min(zlo[tile.plane], corner.z());
+      zhi[tile.plane] = std::max(zhi[tile.plane], corner.z());
+    }
+  }
+
+  for (G4int p=0; p<kNumPlanes; ++p) {
+    faces[p].clear();
+    if (pts[p].empty()) continue;
+    std::vector<Point2> hull = ConvexHull(pts[p]);
+    for (size_t i=0; i<hull.size(); ++i) {
+      const Point2& a = hull[i];
+      const Point2& b = hull[(i+1) % hull.size()];
+      G4ThreeVector n(b.y - a.y, a.x - b.x, 0);
+      n = n.unit();
+      Face face = { n, n.x()*a.x + n.y()*a.y + margin };
+      faces[p].push_back(face);
+    }
+    Face top    = { G4ThreeVector(0, 0,  1),  zhi[p] + margin };
+    Face bottom = { G4ThreeVector(0, 0, -1), -zlo[p] + margin };
+    faces[p].push_back(top);
+    faces[p].push_back(bottom);
+  }
+}
+
+
+G4bool TileHull::Intersects(const G4ThreeVector& pos, const G4ThreeVector& dir,
+                            G4double maxDist) const {
+
+  for (G4int p=0; p<kNumPlanes; ++p) {
+    if (!faces[p].empty() && Clip(faces[p], pos, dir, maxDist)) return true;
+  }
+  return false;
+}
+
+
+G4double TileHull::Distance(const G4ThreeVector& pos) const {
+
+  G4double best = DBL_MAX;
+  for (G4int p=0; p<kNumPlanes; ++p) {
+    if (faces[p].empty()) continue;
+    G4double dist = 0;
+    for (const Face& face : faces[p]) dist = std::max(dist, face.n.dot(pos) - face.d);
+    best = std::min(best, dist);
+  }
+  return best;
+}
+
+
+G4bool TileHull::Clip(const std::vector<Face>& prism, const G4ThreeVector& pos,
+                      const G4ThreeVector& dir, G4double maxDist) const {
+
+  G4double t0 = 0, t1 = maxDist;
+  for (const Face& face : prism) {
+    G4double denom = face.n.dot(dir);
+    G4double num   = face.d - face.n.dot(pos);
+    if (denom == 0) {
+      if (num < 0) return false;
+      continue;
+    }
+    G4double t = num/denom;
+    if (denom > 0) t1 = std::min(t1, t);
+    else           t0 = std::max(t0, t);
+    if (t0 > t1) return false;
+  }
+  return true;
+}
@@ -0,0 +1,44 @@
+#ifndef TileHull_h
+#define TileHull_h 1
+
+#include "TileInfo.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <cfloat>
+#include <vector>
+
+// Convex envelope of the scintillator tiles: for each plane the 2D convex
+// hull of all tile corners in x-y, extruded over the plane's z range. Both
+// prisms are stored as lists of outward half-spaces n.x <= d.
+class TileHull {
+
+public:
+
+  TileHull();
+
+  void Build(const std::vector<TileInfo>& tiles, G4double margin);
+
+  // Does the segment pos + t*dir, 0 <= t <= maxDist, touch either prism?
+  G4bool Intersects(const G4ThreeVector& pos, const G4ThreeVector& dir, 
+                    G4double maxDist = DBL_MAX) const;
+
+  // Lower bound of the distance from pos to the nearest prism
+  G4double Distance(const G4ThreeVector& pos) const;
+
+  G4bool IsBuilt() const { return !faces[kBottomPlane].empty(); }
+
+private:
+
+  struct Face {
+    G4ThreeVector n;
+    G4double      d;
+  };
+
+  G4bool   Clip(const std::vector<Face>& prism, const G4ThreeVector& pos,
+                const G4ThreeVector& dir, G4double maxDist) const;
+
+  std::vector<Face> faces[kNumPlanes];
+};
+
+#endif
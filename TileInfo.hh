@@ -0,0 +1,38 @@
+#ifndef TileInfo_h
+#define TileInfo_h 1
+
+#include "G4AffineTransform.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+
+// Planes of the detector, bottom tiles sit at z<0 and top tiles at z>0
+enum TilePlane { kBottomPlane = 0, kTopPlane = 1, kNumPlanes = 2 };
+
+// One scintillator tile as placed in the final geometry. The tile frame is
+// the G4Trap frame: z along the tile, y across the 2 cm thickness and the
+// half width in x growing linearly from bl1 at -dz to bl2 at +dz.
+struct TileInfo {
+  G4int              id;
+  G4String           name;
+  G4int              plane;
+  G4int              station;   // index into the station array, 0 for a single detector
+  G4VPhysicalVolume* physical;
+  G4LogicalVolume*   logical;
+  G4AffineTransform  toGlobal;
+  G4AffineTransform  toLocal;
+  G4ThreeVector      centre;
+  G4double           dz, dy, bl1, bl2;
+};
+
+// Nominal geometry of the line between two tile centres: length, zenith
+// angle and the time of flight at the speed of light
+struct TilePair {
+  G4double distance;
+  G4double zenith;
+  G4double timeOfFlight;
+};
+
+#endif
@@ -0,0 +1,174 @@
+#include "TrackFitter.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4AutoLock.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <chrono>
+#include <cmath>
+#include <map>
+
+namespace {
+  const size_t kQueueSize = 64;
+
+  G4Mutex fitterMutex = G4MUTEX_INITIALIZER;
+  G4Mutex outputMutex = G4MUTEX_INITIALIZER;
+  std::map<G4String, std::weak_ptr<TrackFitter> > openFitters;
+}
+
+
+void FitBatch::Add(G4int eventId, G4double eventWeight, const std::vector<G4double>& tileEdep,
+                   G4double threshold) {
+
+  if (first.empty()) first.push_back(0);
+  for (size_t k=0; k<tileEdep.size(); ++k) {
+    if (tileEdep[k] <= threshold) continue;
+    tile.push_back((int32_t)k);
+    edep.push_back(tileEdep[k]/CLHEP::MeV);
+  }
+  event.push_back(eventId);
+  weight.push_back(eventWeight);
+  first.push_back((int32_t)tile.size());
+}
+
+
+void FitBatch::Clear() {
+  event.clear();
+  weight.clear();
+  first.clear();
+  tile.clear();
+  edep.clear();
+}
+
+
+std::shared_ptr<TrackFitter> TrackFitter::Open(const G4String& file, const DetectorConstruction* det,
+                                               G4int nThreads) {
+
+  G4AutoLock lock(&fitterMutex);
+  std::shared_ptr<TrackFitter> fitter = openFitters[file].lock();
+  if (!fitter) {
+    fitter.reset(new TrackFitter(file, det, nThreads));
+    openFitters[file] = fitter;
+  }
+  return fitter;
+}
+
+
+TrackFitter::TrackFitter(const G4String& file, const DetectorConstruction* det, G4int nThreads)
+  : fileName(file), filled(kQueueSize), empty(kQueueSize), stopping(false), nFitted(0) {
+
+  out.open(file.c_str(), std::ios::trunc);
+  if (!out) {
+    G4Exception("TrackFitter::TrackFitter", "Output005", FatalException,
+                ("Cannot open track output " + file).c_str());
+    return;
+  }
+  out << "# event weight zenith azimuth hits\n";
+
+  // Tile centroid table, structure of arrays for the fit loops
+  for (const TileInfo& tile : det->GetTiles()) {
+    cx.push_back(tile.centre.x());
+    cy.push_back(tile.centre.y());
+    cz.push_back(tile.centre.z());
+  }
+
+  for (G4int t=0; t<nThreads; ++t) pool.emplace_back(&TrackFitter::Run, this);
+}
+
+
+TrackFitter::~TrackFitter() {
+
+  stopping = true;
+  for (std::thread& thread : pool) thread.join();
+
+  FitBatch* batch;
+  while (empty.TryPop(batch)) delete batch;
+  out.close();
+  G4cout << "TrackFitter: " << nFitted << " tracks written to " << fileName << G4endl;
+}
+
+
+FitBatch* TrackFitter::Acquire() {
+
+  FitBatch* batch;
+  if (empty.TryPop(batch)) return batch;
+  return new FitBatch;
+}
+
+
+void TrackFitter::Submit(FitBatch* batch) {
+
+  while (!filled.TryPush(std::move(batch))) std::this_thread::yield();
+}
+
+
+void TrackFitter::Run() {
+
+  std::vector<float> zenith, azimuth;
+  FitBatch* batch;
+  for (;;) {
+    if (filled.TryPop(batch)) {
+      Fit(*batch, zenith, azimuth);
+      WriteResults(*batch, zenith, azimuth);
+      batch->Clear();
+      if (!empty.TryPush(std::move(batch))) delete batch;
+    } else if (stopping) {
+      if (!filled.TryPop(batch)) break;
+      Fit(*batch, zenith, azimuth);
+      WriteResults(*batch, zenith, azimuth);
+      delete batch;
+    } else {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+}
+
+
+void TrackFitter::Fit(const FitBatch& batch, std::vector<float>& zenith,
+                      std::vector<float>& azimuth) const {
+
+  size_t n = batch.Events();
+  std::vector<G4double> s(n), sz(n), szz(n), sx(n), sxz(n), sy(n), syz(n);
+
+  // Weighted moments of the hit centroids, event by event
+  for (size_t i=0; i<n; ++i) {
+    for (G4int h=batch.first[i]; h<batch.first[i+1]; ++h) {
+      G4int    k = batch.tile[h];
+      G4double w = batch.edep[h];
+      s[i]   += w;
+      sz[i]  += w*cz[k];
+      szz[i] += w*cz[k]*cz[k];
+      sx[i]  += w*cx[k];
+      sxz[i] += w*cx[k]*cz[k];
+      sy[i]  += w*cy[k];
+      syz[i] += w*cy[k]*cz[k];
+    }
+  }
+
+  // Slopes dx/dz and dy/dz for the whole batch, selects only so it
+  // vectorises. The arrival direction is (bx, by, 1) normalised; events with
+  // all hits at one z get NaN.
+  zenith.resize(n);
+  azimuth.resize(n);
+  for (size_t i=0; i<n; ++i) {
+    G4double det = s[i]*szz[i] - sz[i]*sz[i];
+    G4double inv = (det > 0) ? 1./det : 0.;
+    G4double bx  = (s[i]*sxz[i] - sz[i]*sx[i])*inv;
+    G4double by  = (s[i]*syz[i] - sz[i]*sy[i])*inv;
+    zenith[i]  = (det > 0) ? std::atan(std::sqrt(bx*bx + by*by))/CLHEP::deg : NAN;
+    azimuth[i] = std::atan2(by, bx)/CLHEP::deg;
+  }
+}
+
+
+void TrackFitter::WriteResults(const FitBatch& batch, const std::vector<float>& zenith,
+                               const std::vector<float>& azimuth) {
+
+  G4AutoLock lock(&outputMutex);
+  for (size_t i=0; i<batch.Events(); ++i) {
+    out << batch.event[i] << ' ' << batch.weight[i] << ' ' << zenith[i] << ' '
+        << azimuth[i] << ' ' << batch.first[i+1] - batch.first[i] << '\n';
+  }
+  nFitted += batch.Events();
+}
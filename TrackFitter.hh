@@ -0,0 +1,70 @@
+#ifndef TrackFitter_h
+#define TrackFitter_h 1
+
+#include "BoundedQueue.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class DetectorConstruction;
+
+// Hit tiles of a batch of coincidence events, hits of event i are
+// first[i] to first[i+1]
+struct FitBatch {
+  std::vector<int32_t> event;
+  std::vector<float>   weight;
+  std::vector<int32_t> first;
+  std::vector<int32_t> tile;
+  std::vector<float>   edep;
+
+  size_t Events() const { return event.size(); }
+  void   Add(G4int eventId, G4double eventWeight, const std::vector<G4double>& tileEdep,
+             G4double threshold);
+  void   Clear();
+};
+
+// Straight-line fit of coincidence events through the centroids of their
+// hit tiles, run on its own thread pool. Workers fill FitBatches and
+// Submit() them; the fit threads solve x(z) and y(z) by edep-weighted
+// least squares for a whole batch at once and write one line per event:
+//   event, weight, zenith and azimuth [deg] of the arrival direction, hits
+// The azimuth is measured from +x towards +y.
+class TrackFitter {
+
+public:
+
+  static std::shared_ptr<TrackFitter> Open(const G4String& file, const DetectorConstruction* det,
+                                           G4int nThreads);
+
+  ~TrackFitter();
+
+  FitBatch* Acquire();
+  void      Submit(FitBatch* batch);
+
+  size_t GetQueueDepth() const { return filled.Size(); }
+
+private:
+
+  TrackFitter(const G4String& file, const DetectorConstruction* det, G4int nThreads);
+
+  void Run();
+  void Fit(const FitBatch& batch, std::vector<float>& zenith, std::vector<float>& azimuth) const;
+  void WriteResults(const FitBatch& batch, const std::vector<float>& zenith,
+                    const std::vector<float>& azimuth);
+
+  G4String                 fileName;
+  std::ofstream            out;
+  std::vector<G4double>    cx, cy, cz;
+  BoundedQueue<FitBatch*>  filled;
+  BoundedQueue<FitBatch*>  empty;
+  std::atomic<G4bool>      stopping;
+  std::atomic<G4int>       nFitted;
+  std::vector<std::thread> pool;
+};
+
+#endif
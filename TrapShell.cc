@@ -0,0 +1,217 @@
+#include "TrapShell.hh"
+#include "SolidCheck.hh"
+
+#include "G4Polyhedron.hh"
+#include "G4QuickRand.hh"
+#include "G4SolidStore.hh"
+#include "G4SubtractionSolid.hh"
+#include "G4Trap.hh"
+#include "G4VGraphicsScene.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <cmath>
+
+TrapShell::TrapShell(const G4String& name, G4double dz, G4double dy, G4double bl1, G4double bl2,
+                     G4double wall)
+  : G4CSGSolid(name),
+    fOuter(name + "_outer", dz, dy, bl1, bl2),
+    fInner(name + "_inner", dz - wall, dy - wall, bl1 - wall, bl2 - wall),
+    fWall(wall) {
+
+  G4SolidStore::DeRegister(&fOuter);
+  G4SolidStore::DeRegister(&fInner);
+
+  // The cavity must not reach the outer surface anywhere, which for equal
+  // shrinking of all half lengths needs side faces steeper than 45 deg
+  fHalfTolerance = 0.5*kCarTolerance;
+  if (fWall < 2*kCarTolerance || std::abs(bl2 - bl1) >= 2*dz) {
+    G4Exception("TrapShell::TrapShell", "Geom002", FatalException,
+                ("Invalid wall thickness or side slope for solid " + name).c_str());
+  }
+  G4double outerArea = fOuter.GetSurfaceArea();
+  fOuterFraction = outerArea/(outerArea + fInner.GetSurfaceArea());
+}
+
+
+TrapShell::TrapShell(const TrapShell& rhs)
+  : G4CSGSolid(rhs), fOuter(rhs.fOuter), fInner(rhs.fInner), fWall(rhs.fWall),
+    fOuterFraction(rhs.fOuterFraction), fHalfTolerance(rhs.fHalfTolerance) {
+
+  G4SolidStore::DeRegister(&fOuter);
+  G4SolidStore::DeRegister(&fInner);
+}
+
+
+TrapShell& TrapShell::operator=(const TrapShell& rhs) {
+
+  if (this == &rhs) return *this;
+  G4CSGSolid::operator=(rhs);
+  fOuter         = rhs.fOuter;
+  fInner         = rhs.fInner;
+  fWall          = rhs.fWall;
+  fOuterFraction = rhs.fOuterFraction;
+  fHalfTolerance = rhs.fHalfTolerance;
+  return *this;
+}
+
+
+TrapShell::~TrapShell() {}
+
+
+EInside TrapShell::Inside(const G4ThreeVector& p) const {
+
+  G4bool outer;
+  G4double dist = Distance(p, outer);
+  return (dist > fHalfTolerance) ? kOutside : ((dist > -fHalfTolerance) ? kSurface : kInside);
+}
+
+
+G4ThreeVector TrapShell::SurfaceNormal(const G4ThreeVector& p) const {
+
+  G4bool outer;
+  Distance(p, outer);
+  return outer ? fOuter.SymmetricTrap::SurfaceNormal(p) : -fInner.SymmetricTrap::SurfaceNormal(p);
+}
+
+
+G4double TrapShell::DistanceToIn(const G4ThreeVector& p, const G4ThreeVector& v) const {
+
+  // From the cavity the shell starts at the inner wall, from outside at the
+  // outer one, which is never in front of the cavity
+  if (fInner.SignedDistance(p) < fHalfTolerance) return fInner.SymmetricTrap::DistanceToOut(p, v);
+  return fOuter.SymmetricTrap::DistanceToIn(p, v);
+}
+
+
+G4double TrapShell::DistanceToIn(const G4ThreeVector& p) const {
+
+  G4bool outer;
+  G4double dist = Distance(p, outer);
+  return (dist > 0) ? dist : 0.;
+}
+
+
+G4double TrapShell::DistanceToOut(const G4ThreeVector& p, const G4ThreeVector& v,
+                                  const G4bool calcNorm, G4bool* validNorm,
+                                  G4ThreeVector* n) const {
+
+  G4bool validOuter;
+  G4ThreeVector normalOuter;
+  G4double tOuter = fOuter.SymmetricTrap::DistanceToOut(p, v, calcNorm, &validOuter, &normalOuter);
+  G4double tInner = fInner.SymmetricTrap::DistanceToIn(p, v);
+
+  // Leaving into the cavity, the shell lies on both sides of that face
+  if (tInner < tOuter) {
+    if (calcNorm) {
+      *validNorm = false;
+      *n = -fInner.SymmetricTrap::SurfaceNormal(p + tInner*v);
+    }
+    return tInner;
+  }
+  if (calcNorm) {
+    *validNorm = validOuter;
+    *n = normalOuter;
+  }
+  return tOuter;
+}
+
+
+G4double TrapShell::DistanceToOut(const G4ThreeVector& p) const {
+
+  G4bool outer;
+  G4double dist = Distance(p, outer);
+  return (dist < 0) ? -dist : 0.;
+}
+
+
+void TrapShell::BoundingLimits(G4ThreeVector& pMin, G4ThreeVector& pMax) const {
+
+  fOuter.BoundingLimits(pMin, pMax);
+}
+
+
+G4bool TrapShell::CalculateExtent(const EAxis pAxis, const G4VoxelLimits& pVoxelLimit,
+                                  const G4AffineTransform& pTransform,
+                                  G4double& pMin, G4double& pMax) const {
+
+  return fOuter.CalculateExtent(pAxis, pVoxelLimit, pTransform, pMin, pMax);
+}
+
+
+G4double TrapShell::GetCubicVolume() {
+
+  if (fCubicVolume == 0) fCubicVolume = fOuter.GetCubicVolume() - fInner.GetCubicVolume();
+  return fCubicVolume;
+}
+
+
+G4double TrapShell::GetSurfaceArea() {
+
+  if (fSurfaceArea == 0) fSurfaceArea = fOuter.GetSurfaceArea() + fInner.GetSurfaceArea();
+  return fSurfaceArea;
+}
+
+
+G4ThreeVector TrapShell::GetPointOnSurface() const {
+
+  if (G4QuickRand() < fOuterFraction) return fOuter.GetPointOnSurface();
+  return fInner.GetPointOnSurface();
+}
+
+
+G4VSolid* TrapShell::Clone() const {
+
+  return new TrapShell(*this);
+}
+
+
+std::ostream& TrapShell::StreamInfo(std::ostream& os) const {
+
+  G4int oldprc = os.precision(16);
+  os << "-----------------------------------------------------------\n"
+     << "    *** Dump for solid - " << GetName() << " ***\n"
+     << "    ===================================================\n"
+     << " Solid type: TrapShell\n"
+     << " Parameters: \n"
+     << "    half length Z: " << fOuter.GetZHalfLength()/CLHEP::mm << " mm\n"
+     << "    half length Y: " << fOuter.GetYHalfLength()/CLHEP::mm << " mm\n"
+     << "    half length X at -Z: " << fOuter.GetXHalfLength1()/CLHEP::mm << " mm\n"
+     << "    half length X at +Z: " << fOuter.GetXHalfLength2()/CLHEP::mm << " mm\n"
+     << "    wall thickness: " << fWall/CLHEP::mm << " mm\n"
+     << "-----------------------------------------------------------\n";
+  os.precision(oldprc);
+  return os;
+}
+
+
+void TrapShell::DescribeYourselfTo(G4VGraphicsScene& scene) const {
+
+  scene.AddSolid(*this);
+}
+
+
+G4Polyhedron* TrapShell::CreatePolyhedron() const {
+
+  G4Polyhedron* outer = fOuter.CreatePolyhedron();
+  G4Polyhedron* inner = fInner.CreatePolyhedron();
+  G4Polyhedron* shell = new G4Polyhedron(outer->subtract(*inner));
+  delete outer;
+  delete inner;
+  return shell;
+}
+
+
+G4int TrapShell::CrossCheck(G4int nPoints, G4double& timeSelf, G4double& timeBoolean) const {
+
+  const SymmetricTrap& o = fOuter;
+  const SymmetricTrap& i = fInner;
+  G4Trap outer(GetName() + "_outer_check", o.GetZHalfLength(), 0, 0, o.GetYHalfLength(),
+               o.GetXHalfLength1(), o.GetXHalfLength1(), 0, o.GetYHalfLength(),
+               o.GetXHalfLength2(), o.GetXHalfLength2(), 0);
+  G4Trap inner(GetName() + "_inner_check", i.GetZHalfLength(), 0, 0, i.GetYHalfLength(),
+               i.GetXHalfLength1(), i.GetXHalfLength1(), 0, i.GetYHalfLength(),
+               i.GetXHalfLength2(), i.GetXHalfLength2(), 0);
+  G4SubtractionSolid hollow(GetName() + "_check", &outer, &inner);
+  return SolidCheck::Compare(*this, hollow, nPoints, timeSelf, timeBoolean);
+}
@@ -0,0 +1,79 @@
+#ifndef TrapShell_h
+#define TrapShell_h 1
+
+#include "G4CSGSolid.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include "SymmetricTrap.hh"
+
+// Thin-walled hollow SymmetricTrap, the aluminium wrapper around a tile.
+// The cavity is the trap with every half length reduced by the wall
+// thickness, exactly the inner G4Trap of the outer-minus-inner
+// G4SubtractionSolid it replaces.
+//
+// Unlike the Boolean solid, each query evaluates the two traps once and
+// combines them analytically: the shell is outer and not inner, so its
+// signed distance is max(outer, -inner) and the safeties follow directly.
+class TrapShell : public G4CSGSolid {
+
+public:
+
+  TrapShell(const G4String& name, G4double dz, G4double dy, G4double bl1, G4double bl2,
+            G4double wall);
+  TrapShell(const TrapShell& rhs);
+  TrapShell& operator=(const TrapShell& rhs);
+  virtual ~TrapShell();
+
+  const SymmetricTrap& GetOuter() const { return fOuter; }
+  const SymmetricTrap& GetInner() const { return fInner; }
+  G4double GetWallThickness() const { return fWall; }
+
+  EInside       Inside(const G4ThreeVector& p) const;
+  G4ThreeVector SurfaceNormal(const G4ThreeVector& p) const;
+  G4double      DistanceToIn(const G4ThreeVector& p, const G4ThreeVector& v) const;
+  G4double      DistanceToIn(const G4ThreeVector& p) const;
+  G4double      DistanceToOut(const G4ThreeVector& p, const G4ThreeVector& v,
+                              const G4bool calcNorm = false, G4bool* validNorm = 0,
+                              G4ThreeVector* n = 0) const;
+  G4double      DistanceToOut(const G4ThreeVector& p) const;
+
+  void   BoundingLimits(G4ThreeVector& pMin, G4ThreeVector& pMax) const;
+  G4bool CalculateExtent(const EAxis pAxis, const G4VoxelLimits& pVoxelLimit,
+                         const G4AffineTransform& pTransform, G4double& pMin, G4double& pMax) const;
+
+  G4double      GetCubicVolume();
+  G4double      GetSurfaceArea();
+  G4ThreeVector GetPointOnSurface() const;
+
+  G4GeometryType GetEntityType() const { return "TrapShell"; }
+  G4VSolid*      Clone() const;
+  std::ostream&  StreamInfo(std::ostream& os) const;
+
+  void          DescribeYourselfTo(G4VGraphicsScene& scene) const;
+  G4Polyhedron* CreatePolyhedron() const;
+
+  // Compare with the equivalent G4SubtractionSolid of two G4Traps, see
+  // SolidCheck::Compare
+  G4int CrossCheck(G4int nPoints, G4double& timeSelf, G4double& timeBoolean) const;
+
+private:
+
+  // Signed distance, positive outside, and which of the traps is nearer
+  G4double Distance(const G4ThreeVector& p, G4bool& outer) const {
+    G4double dOuter = fOuter.SignedDistance(p);
+    G4double dInner = -fInner.SignedDistance(p);
+    outer = (dOuter >= dInner);
+    return outer ? dOuter : dInner;
+  }
+
+  // Both traps are members and kept out of the solid store, as they are
+  // never placed on their own
+  SymmetricTrap fOuter;
+  SymmetricTrap fInner;
+  G4double      fWall;
+  G4double      fOuterFraction;
+  G4double      fHalfTolerance;
+};
+
+#endif
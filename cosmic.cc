@@ -0,0 +1,36 @@
+#include "ActionInitialization.hh"
+#include "DetectorConstruction.hh"
+
+#include "FTFP_BERT.hh"
+#include "G4RunManagerFactory.hh"
+#include "G4UIExecutive.hh"
+#include "G4UImanager.hh"
+#include "G4VisExecutive.hh"
+
+// cosmic [macro]: runs the macro in batch mode, or opens an interactive
+// session without one
+int main(int argc, char** argv) {
+
+  G4UIExecutive* ui = (argc == 1) ? new G4UIExecutive(argc, argv) : 0;
+
+  G4RunManager* runManager = G4RunManagerFactory::CreateRunManager();
+  DetectorConstruction* detector = new DetectorConstruction();
+  runManager->SetUserInitialization(detector);
+  runManager->SetUserInitialization(new FTFP_BERT);
+  runManager->SetUserInitialization(new ActionInitialization(detector));
+
+  G4VisManager* visManager = new G4VisExecutive;
+  visManager->Initialize();
+
+  G4UImanager* uiManager = G4UImanager::GetUIpointer();
+  if (ui) {
+    ui->SessionStart();
+    delete ui;
+  } else {
+    uiManager->ApplyCommand(G4String("/control/execute ") + argv[1]);
+  }
+
+  delete visManager;
+  delete runManager;
+  return 0;
+}